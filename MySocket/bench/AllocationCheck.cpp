@@ -0,0 +1,187 @@
+#include "TCPSocket.hpp"
+#include "UDPSocket.hpp"
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <new>
+
+/*
+ ? Allocation check:
+ * Steady-state receives into caller-owned memory (receive(char*, size_t), receiveView) must
+ * not touch the heap. The global operator new is replaced by a counting one that is armed only
+ * around the receive calls, so the sends and the setup of the loopback pair don't count.
+ * Sender and receiver share this thread: every batch is sent, then received.
+ *
+ * Usage: mysocket_alloc_check [--port-base PORT]   (exit status 1 when a receive allocated)
+ */
+
+static bool counting = false;
+static uint64_t allocations = 0;
+
+void *operator new(size_t a_size)
+{
+    if (counting)
+    {
+        allocations++;
+    }
+    void *memory = malloc(a_size == 0 ? 1 : a_size);
+    if (memory == nullptr)
+    {
+        throw std::bad_alloc();
+    }
+    return memory;
+}
+
+void operator delete(void *a_memory) noexcept
+{
+    free(a_memory);
+}
+
+void operator delete(void *a_memory, size_t) noexcept
+{
+    free(a_memory);
+}
+
+static const size_t MESSAGE_SIZE = 512;
+static const size_t BATCH = 16;
+static const size_t WARMUP_BATCHES = 8;    /* The first receives may take pool buffers*/
+static const size_t MEASURED_BATCHES = 512;
+
+/* One receive call with the counter armed*/
+template <typename Receive>
+static SocketResult counted(Receive a_receive)
+{
+    counting = true;
+    SocketResult result = a_receive();
+    counting = false;
+    return result;
+}
+
+/* Sends a batch from a_sender, then receives it on a_receiver with a_receive (returns the bytes of one call)*/
+template <typename Receive>
+static bool runBatches(const char *a_name, Socket &a_sender, Receive a_receive)
+{
+    std::string message(MESSAGE_SIZE, 'm');
+    uint64_t before = 0;
+    for (size_t batch = 0; batch < WARMUP_BATCHES + MEASURED_BATCHES; batch++)
+    {
+        if (batch == WARMUP_BATCHES)
+        {
+            before = allocations;
+        }
+        for (size_t i = 0; i < BATCH; i++)
+        {
+            if (!a_sender.send(message).ok())
+            {
+                std::cout << "FAIL " << a_name << " : send failed" << std::endl;
+                return false;
+            }
+        }
+        /* RAW streams may coalesce messages, so the batch is received by bytes, not by calls*/
+        size_t expected = BATCH * MESSAGE_SIZE;
+        while (expected > 0)
+        {
+            SocketResult result = counted(a_receive);
+            if (!result.ok() || result.bytes == 0 || result.bytes > expected)
+            {
+                std::cout << "FAIL " << a_name << " : receive returned " << result.bytes << " bytes, error " << result.errorNumber << std::endl;
+                return false;
+            }
+            expected -= result.bytes;
+        }
+    }
+    uint64_t allocated = allocations - before;
+    std::cout << (allocated == 0 ? "PASS " : "FAIL ") << a_name << " : " << allocated << " allocations in "
+              << MEASURED_BATCHES * BATCH << " messages" << std::endl;
+    return allocated == 0;
+}
+
+static bool checkTCP(const char *a_name, int a_port, FramingType a_framing, bool a_view)
+{
+    TCPSocket listener;
+    TCPSocket client;
+    listener.setReuseAddress(true);
+    if (!listener.bind("127.0.0.1", a_port).ok() || !listener.listen().ok())
+    {
+        std::cout << "FAIL " << a_name << " : could not listen on " << a_port << std::endl;
+        return false;
+    }
+    client.setFraming(a_framing);
+    listener.setFraming(a_framing); /* Inherited by the accepted socket*/
+    if (!client.connect("127.0.0.1", a_port).ok())
+    {
+        std::cout << "FAIL " << a_name << " : could not connect" << std::endl;
+        return false;
+    }
+    std::unique_ptr<Socket> connection(listener.accept());
+    if (!connection)
+    {
+        std::cout << "FAIL " << a_name << " : accept failed" << std::endl;
+        return false;
+    }
+
+    char buffer[MESSAGE_SIZE * BATCH];
+    bool passed = a_view ? runBatches(a_name, client, [&]()
+                                      {
+                                          const char *data;
+                                          size_t length;
+                                          return connection->receiveView(data, length);
+                                      })
+                         : runBatches(a_name, client, [&]()
+                                      { return connection->receive(buffer, sizeof(buffer)); });
+    client.shutdown();
+    connection->shutdown();
+    listener.shutdown();
+    return passed;
+}
+
+static bool checkUDP(const char *a_name, int a_port, bool a_view)
+{
+    UDPSocket receiver;
+    UDPSocket sender;
+    if (!receiver.bind("127.0.0.1", a_port).ok() || !sender.connect("127.0.0.1", a_port).ok())
+    {
+        std::cout << "FAIL " << a_name << " : could not bind " << a_port << std::endl;
+        return false;
+    }
+
+    char buffer[MESSAGE_SIZE];
+    bool passed = a_view ? runBatches(a_name, sender, [&]()
+                                      {
+                                          const char *data;
+                                          size_t length;
+                                          return receiver.receiveView(data, length);
+                                      })
+                         : runBatches(a_name, sender, [&]()
+                                      { return receiver.receive(buffer, sizeof(buffer)); });
+    sender.shutdown();
+    receiver.shutdown();
+    return passed;
+}
+
+int main(int argc, char *argv[])
+{
+    int portBase = 21000;
+    for (int i = 1; i < argc; i++)
+    {
+        std::string argument = argv[i];
+        if (argument == "--port-base" && i + 1 < argc)
+        {
+            portBase = atoi(argv[++i]);
+        }
+        else
+        {
+            std::cerr << "usage: " << argv[0] << " [--port-base PORT]" << std::endl;
+            return 2;
+        }
+    }
+
+    bool passed = true;
+    passed &= checkTCP("tcp_raw_receive", portBase, FramingType::RAW, false);
+    passed &= checkTCP("tcp_framed_receive", portBase + 1, FramingType::LENGTH_PREFIXED, false);
+    passed &= checkTCP("tcp_raw_view", portBase + 2, FramingType::RAW, true);
+    passed &= checkTCP("tcp_framed_view", portBase + 3, FramingType::LENGTH_PREFIXED, true);
+    passed &= checkUDP("udp_receive", portBase + 4, false);
+    passed &= checkUDP("udp_view", portBase + 5, true);
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,220 @@
+#include "Bench.hpp"
+#include <sys/utsname.h> // For uname
+#include <time.h>        // For clock_gettime
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <thread>
+
+static std::string quote(const std::string &a_text)
+{
+    std::string quoted = "\"";
+    for (char c : a_text)
+    {
+        if (c == '"' || c == '\\')
+        {
+            quoted += '\\';
+        }
+        quoted += c;
+    }
+    return quoted + "\"";
+}
+
+static std::string number(double a_value)
+{
+    /* JSON has no NaN/Infinity, a metric that couldn't be measured is null*/
+    if (!std::isfinite(a_value))
+    {
+        return "null";
+    }
+    char text[64];
+    snprintf(text, sizeof(text), "%.6g", a_value);
+    return text;
+}
+
+BenchParams &BenchParams::set(const std::string &a_key, double a_value)
+{
+    entries.emplace_back(a_key, number(a_value));
+    return *this;
+}
+
+BenchParams &BenchParams::set(const std::string &a_key, const std::string &a_value)
+{
+    entries.emplace_back(a_key, quote(a_value));
+    return *this;
+}
+
+double elapsedSeconds(BenchClock::time_point a_start, BenchClock::time_point a_end)
+{
+    return std::chrono::duration<double>(a_end - a_start).count();
+}
+
+double threadCpuSeconds()
+{
+    struct timespec now;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now);
+    return now.tv_sec + now.tv_nsec / 1e9;
+}
+
+double percentile(std::vector<double> &a_samples, double a_percent)
+{
+    if (a_samples.empty())
+    {
+        return NAN;
+    }
+    size_t index = (size_t)std::min<double>(a_samples.size() - 1, std::ceil(a_percent / 100.0 * a_samples.size()) - 1);
+    std::nth_element(a_samples.begin(), a_samples.begin() + index, a_samples.end());
+    return a_samples[index];
+}
+
+double spinHitPct(const SocketCounters &a_counters)
+{
+    uint64_t spins = a_counters.spinReceives + a_counters.spinFallbacks;
+    return spins > 0 ? 100.0 * a_counters.spinReceives / spins : 0;
+}
+
+BenchSuite::BenchSuite(const Options &a_options) : options(a_options), nextPortNumber(a_options.portBase) {}
+
+bool BenchSuite::enabled(const std::string &a_benchmark) const
+{
+    return options.filter.empty() || a_benchmark.find(options.filter) != std::string::npos;
+}
+
+size_t BenchSuite::scale(size_t a_fullCount) const
+{
+    return options.quick ? std::max<size_t>(a_fullCount / 10, 1) : a_fullCount;
+}
+
+int BenchSuite::port()
+{
+    /* A fresh port per run: no TIME_WAIT or leftover datagrams from the previous run*/
+    return nextPortNumber++;
+}
+
+void BenchSuite::measure(const std::string &a_benchmark, const BenchParams &a_params, const std::function<BenchMetrics()> &a_run)
+{
+    if (!enabled(a_benchmark))
+    {
+        return;
+    }
+    std::vector<BenchMetrics> runs;
+    for (int i = 0; i < std::max(options.repeat, 1); i++)
+    {
+        runs.push_back(a_run());
+    }
+
+    /* Median of every metric over the runs (metrics are reported in the same order by every run)*/
+    Record record = {a_benchmark, a_params, runs.front()};
+    for (size_t m = 0; m < record.metrics.size(); m++)
+    {
+        std::vector<double> values;
+        for (const BenchMetrics &run : runs)
+        {
+            values.push_back(run[m].second);
+        }
+        record.metrics[m].second = percentile(values, 50);
+    }
+
+    std::ostringstream line;
+    line << a_benchmark;
+    for (const auto &param : a_params.items())
+    {
+        line << " " << param.first << "=" << param.second;
+    }
+    line << " :";
+    for (const auto &metric : record.metrics)
+    {
+        line << " " << metric.first << "=" << number(metric.second);
+    }
+    std::cout << line.str() << std::endl;
+    records.push_back(std::move(record));
+}
+
+bool BenchSuite::writeJSON() const
+{
+    if (options.output.empty())
+    {
+        return true;
+    }
+    std::ofstream file(options.output);
+    if (!file)
+    {
+        return false;
+    }
+    struct utsname host;
+    uname(&host);
+    file << "{\n  \"suite\": \"mysocket-loopback\",\n";
+    file << "  \"host\": {\"cpus\": " << std::thread::hardware_concurrency()
+         << ", \"kernel\": " << quote(host.release) << ", \"machine\": " << quote(host.machine) << "},\n";
+    file << "  \"options\": {\"quick\": " << (options.quick ? "true" : "false") << ", \"repeat\": " << options.repeat << "},\n";
+    file << "  \"results\": [";
+    for (size_t i = 0; i < records.size(); i++)
+    {
+        const Record &record = records[i];
+        file << (i == 0 ? "\n" : ",\n") << "    {\"benchmark\": " << quote(record.benchmark) << ", \"params\": {";
+        for (size_t p = 0; p < record.params.items().size(); p++)
+        {
+            const auto &param = record.params.items()[p];
+            file << (p == 0 ? "" : ", ") << quote(param.first) << ": " << param.second;
+        }
+        file << "}, \"metrics\": {";
+        for (size_t m = 0; m < record.metrics.size(); m++)
+        {
+            file << (m == 0 ? "" : ", ") << quote(record.metrics[m].first) << ": " << number(record.metrics[m].second);
+        }
+        file << "}}";
+    }
+    file << "\n  ]\n}\n";
+    return file.good();
+}
+
+int main(int argc, char *argv[])
+{
+    BenchSuite::Options options;
+    for (int i = 1; i < argc; i++)
+    {
+        std::string argument = argv[i];
+        bool hasValue = (i + 1 < argc);
+        if (argument == "--quick")
+        {
+            options.quick = true;
+        }
+        else if (argument == "--repeat" && hasValue)
+        {
+            options.repeat = atoi(argv[++i]);
+        }
+        else if (argument == "--filter" && hasValue)
+        {
+            options.filter = argv[++i];
+        }
+        else if (argument == "--output" && hasValue)
+        {
+            options.output = argv[++i];
+        }
+        else if (argument == "--port-base" && hasValue)
+        {
+            options.portBase = atoi(argv[++i]);
+        }
+        else
+        {
+            std::cerr << "usage: " << argv[0] << " [--quick] [--repeat N] [--filter NAME] [--output FILE] [--port-base PORT]" << std::endl;
+            return 2;
+        }
+    }
+
+    BenchSuite suite(options);
+    runTCPBenches(suite);
+    runUDPBenches(suite);
+    runTimerBenches(suite);
+    if (!suite.writeJSON())
+    {
+        std::cerr << "Could not write " << options.output << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,87 @@
+#ifndef BENCH_HPP
+#define BENCH_HPP
+
+#include "SocketStats.hpp"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+/*
+ ? MySocket loopback benchmarks:
+ * Every benchmark is a function that runs one measurement and returns its metrics. The suite
+ * runs each parameter combination `repeat` times and reports the median of every metric, so a
+ * single unlucky scheduling slice doesn't decide the result. Each run uses a fresh port.
+ *
+ * Results are printed as one line per measurement and written as JSON (--output):
+ *   {"suite": ..., "host": {...}, "options": {...},
+ *    "results": [{"benchmark": "tcp_rtt", "params": {...}, "metrics": {...}}, ...]}
+ *
+ * Usage: mysocket_bench [--quick] [--repeat N] [--filter NAME] [--output FILE] [--port-base PORT]
+ */
+
+/* Benchmark parameters, kept in insertion order with their JSON literal*/
+class BenchParams
+{
+private:
+    std::vector<std::pair<std::string, std::string>> entries;
+
+public:
+    BenchParams &set(const std::string &a_key, double a_value);
+    BenchParams &set(const std::string &a_key, const std::string &a_value);
+    BenchParams &set(const std::string &a_key, const char *a_value) { return set(a_key, std::string(a_value)); }
+    const std::vector<std::pair<std::string, std::string>> &items() const { return entries; }
+};
+
+using BenchMetrics = std::vector<std::pair<std::string, double>>;
+
+class BenchSuite
+{
+public:
+    struct Options
+    {
+        bool quick = false;         /* Ten times fewer iterations (smoke run)*/
+        int repeat = 3;             /* Runs per measurement, the median is reported*/
+        std::string filter;         /* Only benchmarks whose name contains this*/
+        std::string output;         /* JSON file (empty: stdout only)*/
+        int portBase = 20000;       /* First loopback port, every run takes the next one*/
+    };
+
+private:
+    struct Record
+    {
+        std::string benchmark;
+        BenchParams params;
+        BenchMetrics metrics;
+    };
+
+    Options options;
+    std::vector<Record> records;
+    int nextPortNumber;
+
+public:
+    explicit BenchSuite(const Options &a_options);
+
+    bool enabled(const std::string &a_benchmark) const;
+    size_t scale(size_t a_fullCount) const;
+    int port();
+    void measure(const std::string &a_benchmark, const BenchParams &a_params, const std::function<BenchMetrics()> &a_run);
+    bool writeJSON() const;
+};
+
+/* Timing and statistics helpers shared by the benchmark files*/
+using BenchClock = std::chrono::steady_clock;
+double elapsedSeconds(BenchClock::time_point a_start, BenchClock::time_point a_end = BenchClock::now());
+double threadCpuSeconds(); /* CPU time of the calling thread (CLOCK_THREAD_CPUTIME_ID), user + system*/
+double percentile(std::vector<double> &a_samples, double a_percent);
+double spinHitPct(const SocketCounters &a_counters); /* Busy-poll receives served while spinning, % of those that spun*/
+
+/* Benchmark groups (one file each)*/
+void runTCPBenches(BenchSuite &a_suite);
+void runUDPBenches(BenchSuite &a_suite);
+void runTimerBenches(BenchSuite &a_suite);
+
+#endif // BENCH_HPP
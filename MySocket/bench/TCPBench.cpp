@@ -0,0 +1,367 @@
+#include "Bench.hpp"
+#include "TCPSocket.hpp"
+#include "ClientChannel.hpp"
+#include "ReactorServerChannel.hpp"
+#include <atomic>
+#include <cmath>
+#include <memory>
+#include <thread>
+
+/*
+ ? LoopbackServer:
+ * ReactorServerChannel on its own thread. Echo mode returns every frame to its sender
+ * (request/response), sink mode only counts the bytes of a raw stream (throughput).
+ * The listener gets the tuning profile of the run, the connections inherit it.
+ */
+class LoopbackServer
+{
+private:
+    EventLoop loop;
+    TCPSocket listener;
+    ReactorServerChannel server;
+    std::thread thread;
+    bool echo;
+    bool started;
+
+public:
+    std::atomic<uint64_t> receivedBytes;
+
+    LoopbackServer(int a_port, bool a_echo, TuningProfile a_profile = TuningProfile::DEFAULT)
+        : server(&listener, loop, a_port, "", a_profile), echo(a_echo), receivedBytes(0)
+    {
+        listener.setReuseAddress(true);
+        if (echo)
+        {
+            server.setFraming(FramingType::LENGTH_PREFIXED);
+        }
+        server.onReadable([this](int a_id, Socket &a_connection)
+                          {
+                              if (echo)
+                              {
+                                  std::string message;
+                                  while (a_connection.receive(message).ok())
+                                  {
+                                      server.send(a_id, message);
+                                  }
+                                  return;
+                              }
+                              char buffer[65536];
+                              while (true)
+                              {
+                                  SocketResult result = a_connection.receive(buffer, sizeof(buffer));
+                                  if (!result.ok() || result.bytes == 0)
+                                  {
+                                      break;
+                                  }
+                                  receivedBytes.fetch_add(result.bytes, std::memory_order_relaxed);
+                              } });
+        started = server.start().ok();
+        if (started)
+        {
+            thread = std::thread([this]()
+                                 { loop.run(); });
+        }
+    }
+
+    bool isStarted() const { return started; }
+
+    ~LoopbackServer()
+    {
+        if (thread.joinable())
+        {
+            loop.stop();
+            thread.join();
+        }
+        server.stop();
+    }
+};
+
+static BenchMetrics unmeasured(std::initializer_list<const char *> a_names)
+{
+    BenchMetrics metrics;
+    for (const char *name : a_names)
+    {
+        metrics.emplace_back(name, NAN);
+    }
+    return metrics;
+}
+
+static const char *backendName(IOBackendType a_backend)
+{
+    return a_backend == IOBackendType::IO_URING ? "io_uring" : "blocking";
+}
+
+static const char *profileName(TuningProfile a_profile)
+{
+    switch (a_profile)
+    {
+    case TuningProfile::LOW_LATENCY:
+        return "low_latency";
+    case TuningProfile::BULK_THROUGHPUT:
+        return "bulk_throughput";
+    case TuningProfile::LOW_MEMORY:
+        return "low_memory";
+    default:
+        return "default";
+    }
+}
+
+static bool connectClients(int a_port, size_t a_count, IOBackendType a_backend, FramingType a_framing,
+                           std::vector<std::unique_ptr<TCPSocket>> &a_sockets, std::vector<std::unique_ptr<ClientChannel>> &a_clients,
+                           TuningProfile a_profile = TuningProfile::DEFAULT)
+{
+    for (size_t i = 0; i < a_count; i++)
+    {
+        a_sockets.emplace_back(new TCPSocket(a_backend));
+        a_clients.emplace_back(new ClientChannel(a_sockets.back().get(), a_port, "127.0.0.1", a_profile));
+        a_clients.back()->setFraming(a_framing);
+        if (!a_clients.back()->start().ok())
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+static double socketBufferKiB(const TCPSocket &a_socket)
+{
+    /* What the kernel actually granted (doubled for bookkeeping, clamped without CAP_NET_ADMIN)*/
+    int sendBuffer = 0;
+    int receiveBuffer = 0;
+    socklen_t length = sizeof(int);
+    getsockopt(a_socket.getFD(), SOL_SOCKET, SO_SNDBUF, &sendBuffer, &length);
+    length = sizeof(int);
+    getsockopt(a_socket.getFD(), SOL_SOCKET, SO_RCVBUF, &receiveBuffer, &length);
+    return (sendBuffer + receiveBuffer) / 1024.0;
+}
+
+static BenchMetrics tcpRoundTrip(BenchSuite &a_suite, size_t a_size, size_t a_connections, IOBackendType a_backend,
+                                 TuningProfile a_profile = TuningProfile::DEFAULT, int a_spinBudgetUs = -1)
+{
+    /*
+     * Every connection has one request in flight: all connections send, then every reply is
+     * awaited in turn. Each channel records its send-to-reply latencies (LatencyRecorder), the
+     * histograms of all connections are merged for the percentiles.
+     *
+     * With a spin budget (0: blocking, for comparison) the clients get setBusyPoll() and the run
+     * also reports spin_hit_pct (replies picked up while spinning) and so_busy_poll_us, the
+     * SO_BUSY_POLL value read back from the first client: setBusyPoll() keeps the user-space spin
+     * when the kernel refuses the option (EPERM), only then it stays below spin_budget_us.
+     */
+    BenchMetrics failed = (a_spinBudgetUs >= 0) ? unmeasured({"rtt_p50_us", "rtt_p99_us", "rtt_p999_us", "rtt_max_us", "requests_per_sec", "spin_hit_pct", "so_busy_poll_us"})
+                                                : unmeasured({"rtt_p50_us", "rtt_p99_us", "rtt_p999_us", "rtt_max_us", "requests_per_sec"});
+    int port = a_suite.port();
+    LoopbackServer server(port, true, a_profile);
+    std::vector<std::unique_ptr<TCPSocket>> sockets;
+    std::vector<std::unique_ptr<ClientChannel>> clients;
+    if (!server.isStarted() || !connectClients(port, a_connections, a_backend, FramingType::LENGTH_PREFIXED, sockets, clients, a_profile))
+    {
+        return failed;
+    }
+
+    int kernelBudgetUs = 0;
+    if (a_spinBudgetUs >= 0)
+    {
+        for (std::unique_ptr<TCPSocket> &socket : sockets)
+        {
+            if (!socket->setBusyPoll(a_spinBudgetUs).ok())
+            {
+                return failed;
+            }
+        }
+        socklen_t length = sizeof(kernelBudgetUs);
+        getsockopt(sockets[0]->getFD(), SOL_SOCKET, SO_BUSY_POLL, &kernelBudgetUs, &length);
+    }
+
+    std::string request(a_size, 'r');
+    const size_t warmup = 100;
+    size_t rounds = std::max<size_t>(a_suite.scale(20000) / a_connections, 1);
+
+    BenchClock::time_point start = BenchClock::now();
+    for (size_t round = 0; round < warmup + rounds; round++)
+    {
+        if (round == warmup)
+        {
+            for (std::unique_ptr<ClientChannel> &client : clients)
+            {
+                client->enableLatencyTracking();
+            }
+            start = BenchClock::now();
+        }
+        for (size_t c = 0; c < a_connections; c++)
+        {
+            clients[c]->send(request);
+            clients[c]->flush();
+        }
+        for (size_t c = 0; c < a_connections; c++)
+        {
+            if (clients[c]->receive().size() != a_size)
+            {
+                return failed;
+            }
+        }
+    }
+    double seconds = elapsedSeconds(start);
+    SocketCounters counters;
+    for (std::unique_ptr<TCPSocket> &socket : sockets)
+    {
+        counters += socket->stats();
+    }
+    LatencyHistogram latency;
+    for (std::unique_ptr<ClientChannel> &client : clients)
+    {
+        latency.merge(client->latencySnapshot());
+        client->stop();
+    }
+    BenchMetrics metrics = {{"rtt_p50_us", latency.percentile(50) / 1e3},
+                            {"rtt_p99_us", latency.percentile(99) / 1e3},
+                            {"rtt_p999_us", latency.percentile(99.9) / 1e3},
+                            {"rtt_max_us", latency.max() / 1e3},
+                            {"requests_per_sec", latency.count() / seconds}};
+    if (a_spinBudgetUs >= 0)
+    {
+        metrics.push_back({"spin_hit_pct", spinHitPct(counters)});
+        metrics.push_back({"so_busy_poll_us", (double)kernelBudgetUs});
+    }
+    return metrics;
+}
+
+static BenchMetrics tcpStream(BenchSuite &a_suite, size_t a_size, size_t a_connections, IOBackendType a_backend, bool a_zeroCopy,
+                              TuningProfile a_profile = TuningProfile::DEFAULT)
+{
+    /*
+     * Raw stream, messages spread round-robin over the connections. Measured until the server
+     * has received every byte (not just until the last send returned). cpu_sec_per_gib is the
+     * sending thread's CPU time (send loop and stop(), which waits for zero-copy completions)
+     * per GiB: the saving zero-copy is about, which loopback throughput alone doesn't show.
+     */
+    BenchMetrics failed = unmeasured({"mib_per_sec", "messages_per_sec", "socket_buffer_kib", "cpu_sec_per_gib"});
+    int port = a_suite.port();
+    LoopbackServer server(port, false, a_profile);
+    std::vector<std::unique_ptr<TCPSocket>> sockets;
+    std::vector<std::unique_ptr<ClientChannel>> clients;
+    if (!server.isStarted() || !connectClients(port, a_connections, a_backend, FramingType::RAW, sockets, clients, a_profile))
+    {
+        return failed;
+    }
+    if (a_zeroCopy)
+    {
+        for (std::unique_ptr<TCPSocket> &socket : sockets)
+        {
+            if (!socket->enableZeroCopy())
+            {
+                return failed;
+            }
+        }
+    }
+
+    size_t messages = std::min(a_suite.scale(1000000), a_suite.scale(256 * 1024 * 1024) / a_size);
+    uint64_t expected = (uint64_t)messages * a_size;
+    std::vector<char> payload(a_size, 's');
+    MessageSegment segment = {payload.data(), payload.size()};
+
+    double bufferKiB = socketBufferKiB(*sockets[0]);
+    BenchClock::time_point start = BenchClock::now();
+    double cpuStart = threadCpuSeconds();
+    for (size_t i = 0; i < messages; i++)
+    {
+        size_t c = i % a_connections;
+        SocketResult result = a_zeroCopy ? sockets[c]->sendZeroCopy(payload.data(), payload.size(), []() {})
+                                         : clients[c]->send(&segment, 1);
+        if (!result.ok())
+        {
+            return failed;
+        }
+    }
+    /* stop() lets queued io_uring sends and pinned zero-copy buffers complete before closing*/
+    for (std::unique_ptr<ClientChannel> &client : clients)
+    {
+        client->stop();
+    }
+    double cpuSeconds = threadCpuSeconds() - cpuStart;
+    while (server.receivedBytes.load(std::memory_order_relaxed) < expected)
+    {
+        if (elapsedSeconds(start) > 20)
+        {
+            return failed;
+        }
+        std::this_thread::sleep_for(std::chrono::microseconds(200));
+    }
+    double seconds = elapsedSeconds(start);
+    return {{"mib_per_sec", expected / seconds / (1024.0 * 1024.0)},
+            {"messages_per_sec", messages / seconds},
+            {"socket_buffer_kib", bufferKiB},
+            {"cpu_sec_per_gib", cpuSeconds / (expected / (1024.0 * 1024.0 * 1024.0))}};
+}
+
+void runTCPBenches(BenchSuite &a_suite)
+{
+    /* Request/response latency over message sizes and concurrent connections*/
+    for (size_t size : {64, 1024, 16384})
+    {
+        for (size_t connections : {1, 16})
+        {
+            a_suite.measure("tcp_rtt", BenchParams().set("message_size", size).set("connections", connections).set("backend", "blocking"),
+                            [&]()
+                            { return tcpRoundTrip(a_suite, size, connections, IOBackendType::BLOCKING); });
+        }
+    }
+
+    /* Streaming throughput*/
+    for (size_t size : {64, 1024, 65536})
+    {
+        for (size_t connections : {1, 4})
+        {
+            a_suite.measure("tcp_stream", BenchParams().set("message_size", size).set("connections", connections).set("backend", "blocking").set("send", "copy"),
+                            [&]()
+                            { return tcpStream(a_suite, size, connections, IOBackendType::BLOCKING, false); });
+        }
+    }
+
+    /* io_uring against blocking system calls (client side)*/
+    for (IOBackendType backend : {IOBackendType::BLOCKING, IOBackendType::IO_URING})
+    {
+        for (size_t size : {64, 1024})
+        {
+            a_suite.measure("tcp_backend_rtt", BenchParams().set("message_size", size).set("connections", 1).set("backend", backendName(backend)),
+                            [&]()
+                            { return tcpRoundTrip(a_suite, size, 1, backend); });
+            a_suite.measure("tcp_backend_stream", BenchParams().set("message_size", size).set("connections", 1).set("backend", backendName(backend)),
+                            [&]()
+                            { return tcpStream(a_suite, size, 1, backend, false); });
+        }
+    }
+
+    /* MSG_ZEROCOPY against copying sends (only large messages are worth pinning)*/
+    for (bool zeroCopy : {false, true})
+    {
+        for (size_t size : {16384, 65536})
+        {
+            a_suite.measure("tcp_zerocopy", BenchParams().set("message_size", size).set("connections", 1).set("send", zeroCopy ? "zerocopy" : "copy"),
+                            [&]()
+                            { return tcpStream(a_suite, size, 1, IOBackendType::BLOCKING, zeroCopy); });
+        }
+    }
+
+    /* Tuning profiles: the same request/response and stream loads under every profile*/
+    for (TuningProfile profile : {TuningProfile::DEFAULT, TuningProfile::LOW_LATENCY, TuningProfile::BULK_THROUGHPUT, TuningProfile::LOW_MEMORY})
+    {
+        a_suite.measure("tcp_tuning_rtt", BenchParams().set("message_size", 64).set("connections", 1).set("profile", profileName(profile)),
+                        [&]()
+                        { return tcpRoundTrip(a_suite, 64, 1, IOBackendType::BLOCKING, profile); });
+        for (size_t size : {1024, 65536})
+        {
+            a_suite.measure("tcp_tuning_stream", BenchParams().set("message_size", size).set("connections", 1).set("profile", profileName(profile)),
+                            [&]()
+                            { return tcpStream(a_suite, size, 1, IOBackendType::BLOCKING, false, profile); });
+        }
+    }
+
+    /* Busy-poll receive against blocking receive on the client (the server is the epoll reactor)*/
+    for (int spinBudgetUs : {0, 50, 200})
+    {
+        a_suite.measure("tcp_busy_poll_rtt", BenchParams().set("message_size", 64).set("connections", 1).set("receive", spinBudgetUs > 0 ? "busy_poll" : "blocking").set("spin_budget_us", spinBudgetUs),
+                        [&]()
+                        { return tcpRoundTrip(a_suite, 64, 1, IOBackendType::BLOCKING, TuningProfile::DEFAULT, spinBudgetUs); });
+    }
+}
@@ -0,0 +1,51 @@
+#include "Bench.hpp"
+#include "EventLoop.hpp"
+#include "LatencyHistogram.hpp"
+#include <memory>
+
+static BenchMetrics timerJitter(BenchSuite &a_suite, size_t a_timerCount, uint64_t a_periodMs)
+{
+    /*
+     * a_timerCount periodic jobs (e.g. publishers) on one EventLoop, their phases spread over the
+     * period. Every run records how late it is against the tick it was scheduled for: the loop
+     * rounds the first expiry up to a whole millisecond of the steady clock (tickAfter()), then
+     * adds the period, so the ideal runs are ceil(now + period) + k periods, not now + period.
+     */
+    EventLoop loop;
+    LatencyHistogram lateness;
+    for (size_t i = 0; i < a_timerCount; i++)
+    {
+        loop.addTimer(i % a_periodMs, [&, a_periodMs]()
+                      {
+                          /* Read before scheduling: the tick can only come out one later, never earlier (lateness isn't understated)*/
+                          uint64_t nowNs = (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(BenchClock::now().time_since_epoch()).count();
+                          auto dueNs = std::make_shared<uint64_t>((nowNs + a_periodMs * 1000000 + 999999) / 1000000 * 1000000);
+                          loop.addPeriodicTimer(a_periodMs, [&, dueNs, a_periodMs]()
+                                                {
+                                                    uint64_t firedNs = (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(BenchClock::now().time_since_epoch()).count();
+                                                    lateness.record(firedNs > *dueNs ? firedNs - *dueNs : 0);
+                                                    *dueNs += a_periodMs * 1000000;
+                                                }); });
+    }
+    uint64_t durationMs = a_suite.scale(2000);
+    loop.addTimer(durationMs, [&]()
+                  { loop.stop(); });
+    BenchClock::time_point start = BenchClock::now();
+    loop.run();
+    double seconds = elapsedSeconds(start);
+    return {{"fires_per_sec", lateness.count() / seconds},
+            {"late_p50_us", lateness.percentile(50) / 1e3},
+            {"late_p99_us", lateness.percentile(99) / 1e3},
+            {"late_max_us", lateness.max() / 1e3}};
+}
+
+void runTimerBenches(BenchSuite &a_suite)
+{
+    /* Timer wheel: periodic jobs on one thread, lateness against the scheduled expiry tick*/
+    for (size_t timers : {100, 1000, 10000})
+    {
+        a_suite.measure("timer_jitter", BenchParams().set("timers", timers).set("period_ms", 10),
+                        [&]()
+                        { return timerJitter(a_suite, timers, 10); });
+    }
+}
@@ -0,0 +1,324 @@
+#include "Bench.hpp"
+#include "UDPSocket.hpp"
+#include "EventLoop.hpp"
+#include "LatencyHistogram.hpp"
+#include <atomic>
+#include <cmath>
+#include <memory>
+#include <thread>
+
+/* Receive buffers large enough that the sender, not the buffer, is what is measured*/
+static void enlargeReceiveBuffer(Socket &a_socket)
+{
+    int size = 8 * 1024 * 1024;
+    setsockopt(a_socket.getFD(), SOL_SOCKET, SO_RCVBUF, &size, sizeof(size));
+}
+
+static BenchMetrics udpUnicast(BenchSuite &a_suite, size_t a_size)
+{
+    /*
+     * Sender and receiver threads over loopback. The receiver drains with recvmmsg and stops after
+     * 500 ms without traffic; received_pps runs from the first send to the last datagram received.
+     */
+    int port = a_suite.port();
+    UDPSocket receiver;
+    if (!receiver.bind("127.0.0.1", port).ok())
+    {
+        return {{"sent_pps", NAN}, {"received_pps", NAN}, {"loss_pct", NAN}};
+    }
+    enlargeReceiveBuffer(receiver);
+    SocketTimeouts timeouts;
+    timeouts.receiveMs = 500;
+    receiver.setTimeouts(timeouts);
+
+    uint64_t received = 0;
+    BenchClock::time_point lastArrival = BenchClock::now();
+    std::thread receiving([&]()
+                          {
+                              DatagramBatch batch(64, 2048);
+                              while (true)
+                              {
+                                  SocketResult result = receiver.receiveBatch(batch);
+                                  if (!result.ok())
+                                  {
+                                      break;
+                                  }
+                                  received += result.bytes;
+                                  lastArrival = BenchClock::now();
+                              } });
+
+    UDPSocket sender;
+    sender.connect("127.0.0.1", port);
+    std::vector<char> payload(a_size, 'u');
+    MessageSegment segment = {payload.data(), payload.size()};
+    size_t count = a_suite.scale(500000);
+    BenchClock::time_point start = BenchClock::now();
+    for (size_t i = 0; i < count; i++)
+    {
+        sender.send(&segment, 1);
+    }
+    double sendSeconds = elapsedSeconds(start);
+    receiving.join();
+    receiver.shutdown();
+    sender.shutdown();
+    return {{"sent_pps", count / sendSeconds},
+            {"received_pps", received / elapsedSeconds(start, lastArrival)},
+            {"loss_pct", 100.0 * (count - received) / count}};
+}
+
+static BenchMetrics udpRoundTrip(BenchSuite &a_suite, size_t a_size, int a_spinBudgetUs)
+{
+    /*
+     * Ping-pong between two blocking sockets, an echo thread and the measuring thread. With a spin
+     * budget both receives busy-poll (Socket::setBusyPoll), otherwise each reply is a sleep/wakeup.
+     * spin_hit_pct: client receives served while spinning, the rest fell back to blocking.
+     */
+    BenchMetrics failed = {{"rtt_p50_us", NAN}, {"rtt_p99_us", NAN}, {"rtt_p999_us", NAN}, {"spin_hit_pct", NAN}};
+    int port = a_suite.port();
+    UDPSocket echo;
+    UDPSocket client;
+    SocketTimeouts timeouts;
+    timeouts.receiveMs = 1000; /* A lost datagram fails the run instead of hanging it*/
+    echo.setTimeouts(timeouts);
+    client.setTimeouts(timeouts);
+    if (!echo.bind("127.0.0.1", port).ok() || !client.connect("127.0.0.1", port).ok() ||
+        !echo.setBusyPoll(a_spinBudgetUs).ok() || !client.setBusyPoll(a_spinBudgetUs).ok())
+    {
+        return failed;
+    }
+    std::thread echoing([&]()
+                        {
+                            std::vector<char> buffer(a_size);
+                            while (true)
+                            {
+                                SocketResult result = echo.receive(buffer.data(), buffer.size());
+                                if (!result.ok() || result.bytes != a_size)
+                                {
+                                    break; /* Timeout, or the 1-byte stop datagram*/
+                                }
+                                MessageSegment segment = {buffer.data(), result.bytes};
+                                echo.send(&segment, 1);
+                            } });
+
+    std::vector<char> request(a_size, 'p');
+    std::vector<char> reply(a_size);
+    MessageSegment segment = {request.data(), request.size()};
+    LatencyHistogram latency;
+    const size_t warmup = 1000;
+    size_t rounds = a_suite.scale(50000);
+    bool complete = true;
+    for (size_t round = 0; round < warmup + rounds && complete; round++)
+    {
+        if (round == warmup)
+        {
+            client.resetStats();
+        }
+        BenchClock::time_point sent = BenchClock::now();
+        client.send(&segment, 1);
+        complete = client.receive(reply.data(), reply.size()).ok();
+        if (round >= warmup)
+        {
+            latency.record((uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(BenchClock::now() - sent).count());
+        }
+    }
+    MessageSegment stop = {"q", 1};
+    client.send(&stop, 1);
+    echoing.join();
+    double hitPct = spinHitPct(client.stats());
+    echo.shutdown();
+    client.shutdown();
+    if (!complete)
+    {
+        return failed;
+    }
+    return {{"rtt_p50_us", latency.percentile(50) / 1e3},
+            {"rtt_p99_us", latency.percentile(99) / 1e3},
+            {"rtt_p999_us", latency.percentile(99.9) / 1e3},
+            {"spin_hit_pct", hitPct}};
+}
+
+static BenchMetrics multicastFanOut(BenchSuite &a_suite, size_t a_groupCount, bool a_batched)
+{
+    /*
+     * One publisher, one receiving socket per group (all drained by one EventLoop thread).
+     * Every tick publishes one 256-byte message to every group, with publish() (one sendmmsg)
+     * or with one send per group. syscalls_per_tick comes from the publisher's stats() for
+     * publish(); the raw sendto calls bypass the socket and are counted here.
+     */
+    BenchMetrics failed = {{"ticks_per_sec", NAN}, {"datagrams_per_sec", NAN}, {"delivered_pct", NAN}, {"syscalls_per_tick", NAN}};
+    std::vector<std::unique_ptr<UDPSocket>> receivers;
+    MulticastGroups groups;
+    for (size_t i = 0; i < a_groupCount; i++)
+    {
+        int port = a_suite.port();
+        std::string group = "239.77.0." + std::to_string(i + 1);
+        receivers.emplace_back(new UDPSocket(CommunicationType::MULTICAST));
+        if (!receivers.back()->JoinMulticast(group, port).ok() || groups.add(group, port) < 0)
+        {
+            return failed;
+        }
+        enlargeReceiveBuffer(*receivers.back());
+        receivers.back()->setNonBlocking(true);
+    }
+
+    EventLoop loop;
+    std::atomic<uint64_t> received(0);
+    DatagramBatch batch(64, 2048);
+    for (std::unique_ptr<UDPSocket> &receiver : receivers)
+    {
+        UDPSocket *socket = receiver.get();
+        loop.add(socket->getFD(), EPOLLIN, [&, socket](uint32_t)
+                 {
+                     SocketResult result = socket->receiveBatch(batch, false);
+                     if (result.ok() && result.bytes > 0)
+                     {
+                         received.fetch_add(result.bytes, std::memory_order_relaxed);
+                     } });
+    }
+    std::thread receiving([&]()
+                          { loop.run(); });
+
+    UDPSocket publisher(CommunicationType::MULTICAST, 1);
+    std::string payload(256, 'm');
+    size_t ticks = a_suite.scale(20000);
+    uint64_t syscalls = 0;
+    SocketCounters before = publisher.stats();
+    BenchClock::time_point start = BenchClock::now();
+    for (size_t tick = 0; tick < ticks; tick++)
+    {
+        if (a_batched)
+        {
+            publisher.publish(groups, payload);
+            continue;
+        }
+        for (size_t i = 0; i < groups.size(); i++)
+        {
+            const struct sockaddr_in &group = groups.destination(i);
+            sendto(publisher.getFD(), payload.data(), payload.size(), 0, (const struct sockaddr *)&group, sizeof(group));
+            syscalls++;
+        }
+    }
+    double seconds = elapsedSeconds(start);
+    if (a_batched)
+    {
+        syscalls = publisher.stats().syscalls - before.syscalls;
+    }
+
+    /* Let the receiver drain, then stop it*/
+    uint64_t seen = 0;
+    do
+    {
+        seen = received.load();
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    } while (received.load() != seen);
+    loop.stop();
+    receiving.join();
+    for (std::unique_ptr<UDPSocket> &receiver : receivers)
+    {
+        loop.remove(receiver->getFD());
+        receiver->shutdown();
+    }
+    publisher.shutdown();
+
+    uint64_t sent = (uint64_t)ticks * a_groupCount;
+    return {{"ticks_per_sec", ticks / seconds},
+            {"datagrams_per_sec", sent / seconds},
+            {"delivered_pct", 100.0 * received.load() / sent},
+            {"syscalls_per_tick", (double)syscalls / ticks}};
+}
+
+static BenchMetrics udpSegmentation(BenchSuite &a_suite, bool a_gso, bool a_gro)
+{
+    /*
+     * 64 datagrams of 1200 bytes per call, sent and then drained by the same thread so both
+     * sides run on one core: pps is datagrams delivered per second of that core.
+     */
+    const size_t segmentSize = 1200;
+    const size_t perCall = 64;
+    int port = a_suite.port();
+    UDPSocket receiver;
+    if (!receiver.bind("127.0.0.1", port).ok() || (a_gro && !receiver.enableGRO().ok()))
+    {
+        return {{"pps", NAN}, {"delivered_pct", NAN}};
+    }
+    enlargeReceiveBuffer(receiver);
+    UDPSocket sender;
+    sender.connect("127.0.0.1", port);
+
+    std::vector<char> buffer(perCall * segmentSize, 'g');
+    DatagramBatch batch(32, 65536);
+    size_t calls = a_suite.scale(4000);
+    uint64_t delivered = 0;
+    BenchClock::time_point start = BenchClock::now();
+    for (size_t call = 0; call < calls; call++)
+    {
+        if (a_gso)
+        {
+            sender.sendSegmented(buffer.data(), buffer.size(), segmentSize);
+        }
+        else
+        {
+            for (size_t i = 0; i < perCall; i++)
+            {
+                MessageSegment segment = {buffer.data() + i * segmentSize, segmentSize};
+                sender.send(&segment, 1);
+            }
+        }
+        while (true)
+        {
+            SocketResult result = receiver.receiveBatch(batch, false);
+            if (!result.ok() || result.bytes == 0)
+            {
+                break;
+            }
+            for (size_t i = 0; i < batch.size(); i++)
+            {
+                delivered += batch.segmentCount(i);
+            }
+        }
+    }
+    double seconds = elapsedSeconds(start);
+    receiver.shutdown();
+    sender.shutdown();
+    return {{"pps", delivered / seconds},
+            {"delivered_pct", 100.0 * delivered / (calls * perCall)}};
+}
+
+void runUDPBenches(BenchSuite &a_suite)
+{
+    /* Unicast packets per second over datagram sizes*/
+    for (size_t size : {64, 512, 1400})
+    {
+        a_suite.measure("udp_pps", BenchParams().set("message_size", size),
+                        [&]()
+                        { return udpUnicast(a_suite, size); });
+    }
+
+    /* Multicast fan-out to many groups: one sendmmsg per tick against one sendto per group*/
+    for (size_t groupCount : {1, 8, 32})
+    {
+        for (bool batched : {false, true})
+        {
+            a_suite.measure("multicast_fanout", BenchParams().set("groups", groupCount).set("message_size", 256).set("send", batched ? "sendmmsg" : "sendto"),
+                            [&]()
+                            { return multicastFanOut(a_suite, groupCount, batched); });
+        }
+    }
+
+    /* Segmentation offload: one send per datagram, GSO, GSO + GRO*/
+    const char *modes[] = {"plain", "gso", "gso_gro"};
+    for (int mode = 0; mode < 3; mode++)
+    {
+        a_suite.measure("udp_gso", BenchParams().set("message_size", 1200).set("mode", modes[mode]),
+                        [&]()
+                        { return udpSegmentation(a_suite, mode > 0, mode > 1); });
+    }
+
+    /* Busy-poll receive against blocking receive (request/response)*/
+    for (int spinBudgetUs : {0, 50, 200})
+    {
+        a_suite.measure("udp_busy_poll_rtt", BenchParams().set("message_size", 64).set("receive", spinBudgetUs > 0 ? "busy_poll" : "blocking").set("spin_budget_us", spinBudgetUs),
+                        [&]()
+                        { return udpRoundTrip(a_suite, 64, spinBudgetUs); });
+    }
+}
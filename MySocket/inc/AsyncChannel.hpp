@@ -0,0 +1,147 @@
+#ifndef ASYNCCHANNEL_HPP
+#define ASYNCCHANNEL_HPP
+
+#include "Channel.hpp"
+#include "EventLoop.hpp"
+#include "AsyncTask.hpp"
+#include <coroutine>
+
+/*
+ ? AsyncChannel:
+ * Coroutine interface over a ClientChannel or ServerChannel. Every operation is awaited and
+ * yields a SocketResult, so a session reads as straight-line code:
+ *
+ *   SocketResult result = co_await channel.start();
+ *   result = co_await channel.send(request);
+ *   result = co_await channel.receive(reply);
+ *
+ * The socket is switched to non-blocking mode without deadlines. An operation first tries the
+ * socket directly (no suspension when data is already there); on WOULD_BLOCK the coroutine is
+ * suspended and the descriptor is watched by the EventLoop until it is readable (receive, accept)
+ * or writable (send, connect), then the operation is retried and the coroutine resumed.
+ * A partial send continues where it stopped, a framed message is never split or re-framed.
+ *
+ * One EventLoop per thread runs any number of sessions; a channel belongs to the loop
+ * (and thread) it was created with. At most one receive and one send may be pending at a time.
+ * Pooled ClientChannels connect (or take a warm connection) synchronously in start().
+ * stop() resumes the pending operations with ECANCELED before it returns.
+ */
+class AsyncChannel
+{
+public:
+    /* Awaitable base: attempt() tries the I/O, the loop retries it until it doesn't WOULD_BLOCK*/
+    class Operation
+    {
+    protected:
+        friend class AsyncChannel;
+
+        AsyncChannel &owner;
+        uint32_t events; /* EPOLLIN or EPOLLOUT: what the socket has to become before a retry*/
+        std::coroutine_handle<> waiting;
+        SocketResult result;
+
+        explicit Operation(AsyncChannel &a_owner, uint32_t a_events) : owner(a_owner), events(a_events) {}
+        virtual bool attempt() = 0; /* True when finished (result is set)*/
+
+    public:
+        Operation(const Operation &) = delete;
+        Operation &operator=(const Operation &) = delete;
+
+        bool await_ready() { return attempt(); }
+        bool await_suspend(std::coroutine_handle<> a_handle);
+
+        virtual ~Operation() = default;
+    };
+
+    class StartOperation : public Operation
+    {
+    private:
+        bool connecting = false;
+        bool attempt() override;
+
+    public:
+        explicit StartOperation(AsyncChannel &a_owner) : Operation(a_owner, EPOLLIN) {}
+        SocketResult await_resume() { return result; }
+    };
+
+    class SendOperation : public Operation
+    {
+    private:
+        MessageSegment single; /* send(std::string): the string as one segment*/
+        const MessageSegment *segments;
+        size_t count;
+        size_t sent = 0;
+        bool attempt() override;
+
+    public:
+        SendOperation(AsyncChannel &a_owner, const MessageSegment *a_segments, size_t a_count);
+        SendOperation(AsyncChannel &a_owner, const std::string &a_message);
+        SocketResult await_resume() { return result; } /* bytes = the whole message (header included) on success*/
+    };
+
+    class ReceiveOperation : public Operation
+    {
+    private:
+        std::string *message;
+        char *buffer;
+        size_t length;
+        bool attempt() override;
+
+    public:
+        ReceiveOperation(AsyncChannel &a_owner, std::string &a_message)
+            : Operation(a_owner, EPOLLIN), message(&a_message), buffer(nullptr), length(0) {}
+        ReceiveOperation(AsyncChannel &a_owner, char *a_buffer, size_t a_length)
+            : Operation(a_owner, EPOLLIN), message(nullptr), buffer(a_buffer), length(a_length) {}
+        SocketResult await_resume() { return result; }
+    };
+
+    /* co_await channel.receive(): the message, empty when nothing was received (like Socket::receive())*/
+    class MessageOperation : public Operation
+    {
+    private:
+        std::string received;
+        bool attempt() override;
+
+    public:
+        explicit MessageOperation(AsyncChannel &a_owner) : Operation(a_owner, EPOLLIN) {}
+        std::string await_resume() { return result.ok() ? std::move(received) : std::string(); }
+    };
+
+private:
+    /** @param  channel : Wrapped channel (owned by the caller). */
+    Channel &channel;
+
+    /** @param  loop : Event loop that resumes the suspended operations. */
+    EventLoop &loop;
+
+    /** @param  watchedFD : Descriptor registered with the loop (-1 while nothing is pending). */
+    int watchedFD;
+
+    /** @param  reader, writer : Suspended operations waiting for EPOLLIN / EPOLLOUT. */
+    Operation *reader;
+    Operation *writer;
+
+    void prepare(Socket *a_socket);
+    bool wait(Operation &a_operation);
+    bool updateRegistration(int a_fd);
+    void onEvents(uint32_t a_events);
+
+public:
+    AsyncChannel(Channel &a_channel, EventLoop &a_loop);
+    AsyncChannel(const AsyncChannel &) = delete;
+    AsyncChannel &operator=(const AsyncChannel &) = delete;
+
+    StartOperation start();
+    SendOperation send(const std::string &message);
+    SendOperation send(const MessageSegment *a_segments, size_t a_count);
+    ReceiveOperation receive(std::string &a_message);
+    ReceiveOperation receive(char *a_buffer, size_t a_length);
+    MessageOperation receive();
+    void stop();
+    Channel &getChannel() const;
+
+    // Destructor for AsyncChannel
+    ~AsyncChannel();
+};
+
+#endif // ASYNCCHANNEL_HPP
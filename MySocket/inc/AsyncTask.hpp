@@ -0,0 +1,142 @@
+#ifndef ASYNCTASK_HPP
+#define ASYNCTASK_HPP
+
+#include <coroutine>
+#include <exception>
+#include <iostream>
+
+/*
+ ? AsyncTask:
+ * Return type of a coroutine that runs on an EventLoop (e.g. one device session):
+ *
+ *   AsyncTask session(AsyncChannel &channel)
+ *   {
+ *       std::string request;
+ *       while ((co_await channel.receive(request)).ok())
+ *       {
+ *           co_await channel.send(request);
+ *       }
+ *   }
+ *
+ * The coroutine starts running immediately and suspends at the first co_await that has to wait
+ * for the socket, then the loop resumes it. Dropping the AsyncTask detaches it: the coroutine
+ * keeps running and frees itself when it returns. Another coroutine may co_await the task to
+ * wait for its end (an exception thrown by the task is rethrown there).
+ *
+ * An exception nobody can rethrow (the task was detached, or dropped unawaited after it ended)
+ * goes to the exception handler instead of being lost; the default one prints it to std::cerr.
+ * The handler runs inside the loop and must not throw.
+ */
+class AsyncTask
+{
+public:
+    using ExceptionHandler = void (*)(std::exception_ptr a_exception);
+
+    /* Replaces the handler of unobserved exceptions (nullptr restores the default), returns the previous one*/
+    static ExceptionHandler setExceptionHandler(ExceptionHandler a_handler)
+    {
+        ExceptionHandler previous = exceptionHandler;
+        exceptionHandler = (a_handler != nullptr) ? a_handler : reportException;
+        return previous;
+    }
+
+    struct promise_type
+    {
+        std::coroutine_handle<> continuation;
+        std::exception_ptr exception;
+        bool detached = false;
+
+        AsyncTask get_return_object() { return AsyncTask(std::coroutine_handle<promise_type>::from_promise(*this)); }
+        std::suspend_never initial_suspend() noexcept { return {}; }
+
+        /* Hands control to the awaiting coroutine, or frees a detached frame*/
+        struct FinalAwaiter
+        {
+            bool await_ready() noexcept { return false; }
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> a_handle) noexcept
+            {
+                promise_type &promise = a_handle.promise();
+                if (promise.detached)
+                {
+                    if (promise.exception)
+                    {
+                        exceptionHandler(promise.exception);
+                    }
+                    a_handle.destroy();
+                    return std::noop_coroutine();
+                }
+                return promise.continuation ? promise.continuation : std::noop_coroutine();
+            }
+            void await_resume() noexcept {}
+        };
+        FinalAwaiter final_suspend() noexcept { return {}; }
+
+        void return_void() {}
+        void unhandled_exception() { exception = std::current_exception(); }
+    };
+
+private:
+    std::coroutine_handle<promise_type> handle;
+
+    static void reportException(std::exception_ptr a_exception)
+    {
+        try
+        {
+            std::rethrow_exception(a_exception);
+        }
+        catch (const std::exception &exception)
+        {
+            std::cerr << "AsyncTask ended with an unobserved exception: " << exception.what() << std::endl;
+        }
+        catch (...)
+        {
+            std::cerr << "AsyncTask ended with an unobserved unknown exception" << std::endl;
+        }
+    }
+
+    static inline ExceptionHandler exceptionHandler = reportException;
+
+    explicit AsyncTask(std::coroutine_handle<promise_type> a_handle) : handle(a_handle) {}
+
+public:
+    AsyncTask(AsyncTask &&a_other) noexcept : handle(a_other.handle) { a_other.handle = nullptr; }
+    AsyncTask(const AsyncTask &) = delete;
+    AsyncTask &operator=(const AsyncTask &) = delete;
+
+    bool done() const { return !handle || handle.done(); }
+
+    /* co_await task: resumes the caller once the task returned*/
+    bool await_ready() const { return done(); }
+    void await_suspend(std::coroutine_handle<> a_caller) { handle.promise().continuation = a_caller; }
+    void await_resume()
+    {
+        if (handle && handle.promise().exception)
+        {
+            /* Taken out of the promise: rethrown once, not reported again when the task is dropped*/
+            std::exception_ptr exception = handle.promise().exception;
+            handle.promise().exception = nullptr;
+            std::rethrow_exception(exception);
+        }
+    }
+
+    ~AsyncTask()
+    {
+        if (handle)
+        {
+            if (handle.done())
+            {
+                if (handle.promise().exception)
+                {
+                    exceptionHandler(handle.promise().exception);
+                }
+                handle.destroy();
+            }
+            else
+            {
+                handle.promise().detached = true;
+            }
+        }
+    }
+};
+
+#endif // ASYNCTASK_HPP
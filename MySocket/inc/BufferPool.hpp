@@ -0,0 +1,140 @@
+#ifndef BUFFERPOOL_HPP
+#define BUFFERPOOL_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+/*
+ ? BufferPool:
+ * Process-wide allocator for receive buffers. Memory is reserved in large slabs (mmap, optionally
+ * backed by huge pages and prefaulted) which are cut into fixed-size buffers of one size class
+ * (1 KiB .. 64 KiB, powers of two). Buffers are never returned to the OS, they cycle between:
+ *
+ *   thread cache  : per thread and per class, no locking (the common case for acquire/release).
+ *   global list   : per class, mutex protected, refills and drains the thread caches in batches.
+ *
+ * So the receive path doesn't go through malloc, doesn't fragment the heap, and reuses the
+ * same (already faulted-in, cache-warm) memory. Requests above the largest class fall back to
+ * the heap and are counted as misses.
+ *
+ * configure() must be called before the first buffer is taken (e.g. at startup, followed by
+ * reserve() to prefault the expected working set).
+ */
+class BufferPool
+{
+public:
+    static constexpr size_t MIN_BUFFER_SIZE = 1024;
+    static constexpr size_t MAX_BUFFER_SIZE = 64 * 1024;
+    static constexpr size_t CLASS_COUNT = 7; /* 1, 2, 4, 8, 16, 32, 64 KiB*/
+
+    struct Config
+    {
+        size_t slabSize = 2 * 1024 * 1024; /* Bytes reserved per slab (one huge page)*/
+        bool hugePages = false;             /* MAP_HUGETLB, falls back to madvise(MADV_HUGEPAGE)*/
+        bool prefault = false;              /* MAP_POPULATE: page faults happen at reserve time*/
+        size_t threadCacheLimit = 64;       /* Buffers per class a thread keeps before giving half back*/
+    };
+
+    struct Stats
+    {
+        uint64_t hits;     /* Served from a thread cache or the global list*/
+        uint64_t misses;   /* Needed a new slab, or larger than MAX_BUFFER_SIZE (heap)*/
+        uint64_t slabs;    /* Slabs reserved so far*/
+        uint64_t reservedBytes;
+        bool hugePages;    /* At least one slab is backed by MAP_HUGETLB pages*/
+    };
+
+    /*
+     ? Buffer: move-only handle, the memory goes back to the pool when it is destroyed.
+     */
+    class Buffer
+    {
+    private:
+        char *memory;
+        size_t size;
+
+    public:
+        Buffer() : memory(nullptr), size(0) {}
+        explicit Buffer(size_t a_minimumSize);
+        Buffer(Buffer &&a_other) noexcept;
+        Buffer &operator=(Buffer &&a_other) noexcept;
+        Buffer(const Buffer &) = delete;
+        Buffer &operator=(const Buffer &) = delete;
+
+        char *data() const { return memory; }
+        size_t capacity() const { return size; }
+
+        /* Swaps to a buffer of at least a_minimumSize, keeping the first a_keepBytes*/
+        void grow(size_t a_minimumSize, size_t a_keepBytes);
+        void reset();
+
+        ~Buffer();
+    };
+
+private:
+    struct FreeBuffer
+    {
+        FreeBuffer *next;
+    };
+
+    struct SizeClass
+    {
+        std::mutex lock;
+        FreeBuffer *head = nullptr;
+        size_t count = 0;
+    };
+
+    /*
+     * Hits and misses are counted per thread (only the owner writes them, a relaxed load and store),
+     * so acquire() never writes a cache line shared with other threads. stats() sums the live caches
+     * and what exited threads left in retiredHits/retiredMisses.
+     */
+    struct ThreadCache
+    {
+        FreeBuffer *head[CLASS_COUNT] = {};
+        size_t count[CLASS_COUNT] = {};
+        std::atomic<uint64_t> hits{0};
+        std::atomic<uint64_t> misses{0};
+        ThreadCache();
+        ~ThreadCache();
+    };
+
+    Config config;
+    SizeClass classes[CLASS_COUNT];
+
+    /** @param  caches : Thread caches of the live threads (registered on creation, locked by cachesLock). */
+    mutable std::mutex cachesLock;
+    std::vector<ThreadCache *> caches;
+    uint64_t retiredHits;
+    uint64_t retiredMisses;
+    std::atomic<uint64_t> slabs;
+    std::atomic<uint64_t> reservedBytes;
+    std::atomic<bool> hugePagesUsed;
+
+    BufferPool();
+    static ThreadCache &threadCache();
+    static size_t classIndex(size_t a_size);
+    static size_t classSize(size_t a_index);
+    static void count(std::atomic<uint64_t> &a_counter);
+    bool addSlab(size_t a_index);
+    void pushGlobal(size_t a_index, FreeBuffer *a_first, FreeBuffer *a_last, size_t a_count);
+
+public:
+    BufferPool(const BufferPool &) = delete;
+    BufferPool &operator=(const BufferPool &) = delete;
+
+    static BufferPool &instance();
+
+    bool configure(const Config &a_config);
+    void reserve(size_t a_bufferSize, size_t a_count);
+
+    char *acquire(size_t a_minimumSize, size_t &a_capacity);
+    void release(char *a_buffer, size_t a_capacity);
+
+    Stats stats() const;
+};
+
+#endif // BUFFERPOOL_HPP
@@ -0,0 +1,52 @@
+#ifndef BYTEORDER_HPP
+#define BYTEORDER_HPP
+
+#include <endian.h> // For htobe16/be16toh ...
+#include <cstdint>
+#include <cstring>
+
+/*
+ ? Big-endian (network order) loads and stores at any address.
+ * Received bytes have no alignment guarantee (a frame can start anywhere in a receive buffer),
+ * so fields are copied with memcpy, which compiles to a plain (unaligned) load/store plus a bswap.
+ */
+inline uint16_t loadBigEndian16(const char *a_at)
+{
+    uint16_t value;
+    memcpy(&value, a_at, sizeof(value));
+    return be16toh(value);
+}
+
+inline uint32_t loadBigEndian32(const char *a_at)
+{
+    uint32_t value;
+    memcpy(&value, a_at, sizeof(value));
+    return be32toh(value);
+}
+
+inline uint64_t loadBigEndian64(const char *a_at)
+{
+    uint64_t value;
+    memcpy(&value, a_at, sizeof(value));
+    return be64toh(value);
+}
+
+inline void storeBigEndian16(char *a_at, uint16_t a_value)
+{
+    a_value = htobe16(a_value);
+    memcpy(a_at, &a_value, sizeof(a_value));
+}
+
+inline void storeBigEndian32(char *a_at, uint32_t a_value)
+{
+    a_value = htobe32(a_value);
+    memcpy(a_at, &a_value, sizeof(a_value));
+}
+
+inline void storeBigEndian64(char *a_at, uint64_t a_value)
+{
+    a_value = htobe64(a_value);
+    memcpy(a_at, &a_value, sizeof(a_value));
+}
+
+#endif // BYTEORDER_HPP
@@ -17,10 +17,18 @@ protected:
 public:
     explicit Channel(Socket *socket) : channelSocket(socket) {}
 
-    virtual void start() = 0;
+    virtual SocketResult start() = 0; /* The first failing step (bind/listen/connect), see SocketResult*/
     virtual void stop() = 0;
-    virtual void send(const std::string &message) = 0;
+    virtual SocketResult send(const std::string &message) = 0;
+    virtual SocketResult send(const MessageSegment *a_segments, size_t a_count) { return channelSocket->send(a_segments, a_count); } /* Scatter-gather, see Socket*/
     virtual std::string receive() = 0;
+    virtual SocketResult receive(char *a_buffer, size_t a_length) { return channelSocket->receive(a_buffer, a_length); } /* No allocation, see Socket::receive(char*, size_t)*/
+    virtual void setTimeouts(const SocketTimeouts &a_timeouts) { channelSocket->setTimeouts(a_timeouts); } /* Call before start() so the connect (and accepted sockets) use them*/
+    virtual void setFraming(FramingType a_framing) { channelSocket->setFraming(a_framing); } /* Call before start() so accepted sockets inherit it*/
+    virtual SocketResult setTuning(const SocketTuning &a_tuning) { return channelSocket->setTuning(a_tuning); } /* Call before start(), see TuningProfile*/
+    virtual void flush() { channelSocket->flush(); } /* Submits sends queued by a batching (io_uring) socket*/
+    virtual Socket *getSocket() const { return channelSocket; } /* The socket receive() reads from*/
+    virtual SocketCounters stats() const { return (channelSocket != nullptr) ? channelSocket->stats() : SocketCounters{}; } /* Summed over every socket of the channel, see SocketStats*/
 
     virtual ~Channel() = default;
 };
@@ -2,6 +2,9 @@
 #define CLIENTCHANNEL_HPP
 
 #include "Channel.hpp"
+#include "ConnectionPool.hpp"
+#include "LatencyRecorder.hpp"
+#include <memory>
 
 // Derived Class: ClientChannel
 class ClientChannel : public Channel
@@ -11,11 +14,61 @@ private:
 
     const std::string ip; /** Data member to store the ip*/
 
+    /*
+     * Pooled channel: start() acquires a connection from the pool instead of connecting,
+     * stop() returns it. Framing and timeouts then come from the pool.
+     */
+    /** @param  pool : Pool the connection is borrowed from (nullptr for a plain channel). */
+    ConnectionPool *pool;
+
+    /** @param  pooledConnection : The borrowed connection while the channel is ON. */
+    TCPSocket *pooledConnection;
+
+    /** @param  reusable : Cleared by a timeout/error, the connection is then closed instead of returned. */
+    bool reusable;
+
+    /*
+     * A pooled connection's counters cover every channel that borrowed it, so the channel keeps
+     * its own share: what the connection counted between acquire (borrowedBaseline) and release,
+     * summed over the connections it borrowed so far (returnedCounters).
+     */
+    SocketCounters borrowedBaseline;
+    SocketCounters returnedCounters;
+
+    /*
+     * Latency tracking (request/response): the send time of every unanswered request is queued,
+     * and each message received is the reply to the oldest one. The queue is bounded, a request
+     * that never gets a reply is dropped once MAX_UNANSWERED newer ones are waiting.
+     */
+    static constexpr size_t MAX_UNANSWERED = 256;
+
+    /** @param  latency : Send-to-reply latencies (nullptr while tracking is off). */
+    std::unique_ptr<LatencyRecorder> latency;
+
+    /** @param  sentAt : Ring of send times (steady clock, ns) of the unanswered requests. */
+    std::vector<uint64_t> sentAt;
+    size_t sentHead;
+    size_t sentCount;
+
+    SocketResult track(SocketResult a_result);
+    void requestSent(uint64_t a_sentAt, const SocketResult &a_result);
+    void replyReceived(bool a_received);
+
 public:
-    explicit ClientChannel(Socket *a_socket, int a_port, std::string a_ip);
-    void start() override;
-    void send(const std::string &message) override;
+    explicit ClientChannel(Socket *a_socket, int a_port, std::string a_ip, TuningProfile a_profile = TuningProfile::DEFAULT);
+    explicit ClientChannel(ConnectionPool &a_pool);
+    SocketResult start() override;
+    SocketResult send(const std::string &message) override;
+    SocketResult send(const MessageSegment *a_segments, size_t a_count) override;
     std::string receive() override;
+    SocketResult receive(char *a_buffer, size_t a_length) override;
+    void setFraming(FramingType a_framing) override;
+    void setTimeouts(const SocketTimeouts &a_timeouts) override;
+    SocketResult setTuning(const SocketTuning &a_tuning) override;
+    void flush() override;
+    void enableLatencyTracking(bool a_enable = true); /* One receive per reply: use LENGTH_PREFIXED framing*/
+    LatencyHistogram latencySnapshot() const; /* Any thread; merge() the snapshots of several channels*/
+    SocketCounters stats() const override; /* Pooled: this channel's traffic, kept across stop()/start()*/
     void stop() override; 
     // Destructor for ClientChannel
     ~ClientChannel();
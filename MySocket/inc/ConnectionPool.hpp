@@ -0,0 +1,77 @@
+#ifndef CONNECTIONPOOL_HPP
+#define CONNECTIONPOOL_HPP
+
+#include "TCPSocket.hpp"
+#include <deque>
+#include <mutex>
+
+/*
+ ? ConnectionPool:
+ * Keeps up to poolSize connected TCPSockets to one endpoint (ip:port) so short-lived channels
+ * don't pay a TCP handshake each time. acquire() hands out an idle connection (or connects a new
+ * one when none is left), release() takes it back for the next user.
+ *
+ * Every idle connection is health-checked (TCPSocket::isReusable) when it is handed out and when
+ * it comes back: one the server closed meanwhile, with a pending error or with unread input is
+ * closed instead of being reused. Optional TCP Fast Open puts the first request of a freshly
+ * connected socket in the SYN, so even a pool miss saves the connection round trip.
+ *
+ * The pool is thread-safe. Connections use the blocking backend of the thread that created them.
+ */
+class ConnectionPool
+{
+private:
+    const std::string ip; /** Data member to store the ip*/
+
+    int port; /** Data member to store the port*/
+
+    /** @param  poolSize : Maximum number of idle connections kept open. */
+    size_t poolSize;
+
+    /** @param  timeouts : Applied to every pooled connection (connectMs bounds warmUp/acquire). */
+    SocketTimeouts timeouts;
+
+    /** @param  framing : Framing of the pooled connections (must match the server). */
+    FramingType framing = FramingType::RAW;
+
+    /** @param  fastOpen : Connect with TCP_FASTOPEN_CONNECT. */
+    bool fastOpen = false;
+
+    /** @param  tuning : Socket options of every new connection, set before its connect. */
+    SocketTuning tuning;
+
+    /** @param  idle : Healthy connected sockets waiting for acquire(), most recently used at the back. */
+    std::deque<TCPSocket *> idle;
+
+    /** @param  reused / connected : acquire() served from the pool / by a new connection. */
+    size_t reused = 0;
+    size_t connected = 0;
+
+    mutable std::mutex lock;
+
+    SocketResult connectNew(TCPSocket *&a_connection);
+
+public:
+    explicit ConnectionPool(const std::string a_ip, int a_port, size_t a_poolSize = 4);
+    ConnectionPool(const ConnectionPool &) = delete;
+    ConnectionPool &operator=(const ConnectionPool &) = delete;
+
+    void setTimeouts(const SocketTimeouts &a_timeouts);
+    void setFraming(FramingType a_framing);
+    void setFastOpen(bool a_enable);
+    void setTuning(const SocketTuning &a_tuning);
+
+    SocketResult warmUp();
+    SocketResult acquire(TCPSocket *&a_connection);
+    void release(TCPSocket *a_connection, bool a_reusable = true);
+    void clear();
+
+    size_t idleCount() const;
+    size_t reusedCount() const;
+    size_t connectedCount() const;
+
+    // Destructor for ConnectionPool
+    ~ConnectionPool();
+};
+
+#endif // CONNECTIONPOOL_HPP
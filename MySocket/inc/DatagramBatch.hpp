@@ -0,0 +1,65 @@
+#ifndef DATAGRAMBATCH_HPP
+#define DATAGRAMBATCH_HPP
+
+#include <netinet/in.h> // For sockaddr_in
+#include <sys/socket.h> // For mmsghdr
+#include <sys/uio.h>    // For iovec
+#include <cstddef>
+#include <vector>
+
+/*
+ ? DatagramBatch:
+ * Preallocated receive slots for UDPSocket::receiveBatch(). Every slot has a fixed-size payload
+ * buffer, an iovec, an mmsghdr and a sockaddr_in for the sender, all allocated once in the
+ * constructor and wired together, so a batch receive is one recvmmsg call with no allocation.
+ *
+ * After receiveBatch() reports n datagrams (result.bytes), slots [0, n) hold the received datagrams until the next call.
+ *
+ * With UDP_GRO enabled on the socket (UDPSocket::enableGRO) one slot may hold several datagrams
+ * of the same sender coalesced by the kernel: segmentCount(i) datagrams of segmentSize(i) bytes,
+ * the last one possibly shorter. Use 64 KiB slots then, otherwise the coalesced data is truncated.
+ * Without GRO every slot is exactly one segment.
+ */
+class DatagramBatch
+{
+private:
+    /** @param  slotSize : Maximum payload bytes per datagram (longer datagrams are truncated). */
+    size_t slotSize;
+
+    /** @param  storage : One contiguous block holding every slot's payload (capacity * slotSize). */
+    std::vector<char> storage;
+
+    /** @param  segments / headers / senders : Per-slot recvmmsg bookkeeping. */
+    std::vector<struct iovec> segments;
+    std::vector<struct mmsghdr> headers;
+    std::vector<struct sockaddr_in> senders;
+
+    /** @param  controls / segmentSizes : UDP_GRO control message space and the parsed segment size per slot. */
+    std::vector<char> controls;
+    std::vector<size_t> segmentSizes;
+
+    /** @param  received : Number of slots filled by the last receiveBatch(). */
+    size_t received;
+
+    friend class UDPSocket;
+    void prepare();
+    void parseSegments(size_t a_count);
+
+public:
+    explicit DatagramBatch(size_t a_capacity = 64, size_t a_slotSize = 2048);
+    DatagramBatch(const DatagramBatch &) = delete;
+    DatagramBatch &operator=(const DatagramBatch &) = delete;
+
+    size_t capacity() const;
+    size_t size() const;
+    const char *data(size_t a_index) const;
+    size_t length(size_t a_index) const;
+    bool truncated(size_t a_index) const;
+    const struct sockaddr_in &sender(size_t a_index) const;
+    size_t segmentSize(size_t a_index) const;
+    size_t segmentCount(size_t a_index) const;
+    const char *segment(size_t a_index, size_t a_segment) const;
+    size_t segmentLength(size_t a_index, size_t a_segment) const;
+};
+
+#endif // DATAGRAMBATCH_HPP
@@ -0,0 +1,88 @@
+#ifndef EVENTLOOP_HPP
+#define EVENTLOOP_HPP
+
+#include <sys/epoll.h> // For epoll_create1, epoll_ctl and epoll_wait
+#include "TimerWheel.hpp"
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+/*
+ ? EventLoop:
+ * A single-threaded readiness loop around epoll. Any file descriptor (listening socket,
+ * connected socket, timerfd, eventfd...) is registered with the events it is interested in
+ * and a callback that receives the ready events (EPOLLIN, EPOLLOUT, EPOLLRDHUP, EPOLLHUP, EPOLLERR).
+ *
+ * Registrations are level-triggered: a callback that does not drain a descriptor is simply
+ * called again on the next iteration, so handlers may read one message per wakeup.
+ *
+ * Timers (periodic publishing, read timeouts, retransmits) run on the same thread from a
+ * hierarchical TimerWheel with 1 ms ticks: epoll_wait sleeps until the next timer is due, and
+ * due timers fire after the ready descriptors of that iteration. A timer never fires early: its
+ * delay is rounded up to a whole tick, so it expires up to one tick after now + delay. Against
+ * that expiry tick it fires within about one tick (epoll_wait's millisecond timeout) plus the
+ * time the other callbacks of the iteration take; timer_jitter measures p50 0.55 ms and p99
+ * 1.1-2.6 ms for 100-10000 timers. There is no hard bound: when the thread is preempted the
+ * timers are as late as the scheduler makes them (max 2-12 ms on a loaded single-CPU host).
+ * Like add()/remove(), the timer functions must be called from the loop's thread.
+ */
+class EventLoop
+{
+public:
+    using EventCallback = std::function<void(uint32_t a_events)>;
+    using TimerId = TimerWheel::TimerId;
+    using TimerCallback = TimerWheel::TimerCallback;
+
+private:
+    /** @param  epollFD : File descriptor of the epoll instance. */
+    int epollFD;
+
+    /** @param  stopRequested : Set by stop() (from any thread) to leave run(). */
+    std::atomic<bool> stopRequested;
+
+    /** @param  wakeFD : eventfd watched by the loop so another thread can interrupt epoll_wait. */
+    int wakeFD;
+
+    /** @param  readyEvents : Output array for epoll_wait, sized once at construction. */
+    std::vector<struct epoll_event> readyEvents;
+
+    /*
+     * Callbacks are held by shared_ptr so a handler can remove (or re-add) its own descriptor
+     * while it is being dispatched without destroying the std::function it is running in.
+     */
+    /** @param  callbacks : Registered callback for every watched descriptor. */
+    std::unordered_map<int, std::shared_ptr<EventCallback>> callbacks;
+
+    /** @param  timers : Timer wheel, one tick per millisecond of the steady clock. */
+    TimerWheel timers;
+
+    static uint64_t nowNanoseconds();
+    uint64_t tickAfter(uint64_t a_delayMs) const;
+
+public:
+    explicit EventLoop(int a_maxEventsPerWait = 1024);
+    EventLoop(const EventLoop &) = delete;
+    EventLoop &operator=(const EventLoop &) = delete;
+
+    bool add(int a_fd, uint32_t a_events, EventCallback a_callback);
+    bool modify(int a_fd, uint32_t a_events);
+    void remove(int a_fd);
+    bool isWatching(int a_fd) const;
+
+    TimerId addTimer(uint64_t a_delayMs, TimerCallback a_callback);
+    TimerId addPeriodicTimer(uint64_t a_periodMs, TimerCallback a_callback); /* First run after one period*/
+    bool rescheduleTimer(TimerId a_id, uint64_t a_delayMs); /* e.g. push a read timeout back on activity*/
+    bool cancelTimer(TimerId a_id);
+    size_t timerCount() const;
+
+    int runOnce(int a_timeoutMs = -1); /* Descriptors dispatched + timers fired*/
+    void run();
+    void stop();
+    void wakeup();
+
+    ~EventLoop();
+};
+
+#endif // EVENTLOOP_HPP
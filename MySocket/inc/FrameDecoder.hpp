@@ -0,0 +1,55 @@
+#ifndef FRAMEDECODER_HPP
+#define FRAMEDECODER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/*
+ ? FrameDecoder:
+ * Reassembles length-prefixed frames from a TCP byte stream.
+ * Wire format: [4-byte payload length, big-endian][payload].
+ *
+ * Bytes are received directly into the decoder (prepare() + commit()), one read may complete
+ * several frames (they are all kept) and a frame split across reads stays buffered until its
+ * remaining bytes arrive. nextFrame() hands out a view into the internal buffer, valid until
+ * the next prepare()/feed().
+ */
+class FrameDecoder
+{
+private:
+    /** @param  buffer : Received bytes, consumed from readOffset up to writeOffset. */
+    std::vector<char> buffer;
+    size_t readOffset;
+    size_t writeOffset;
+
+    /** @param  maxFrameSize : Larger length prefixes are treated as a corrupted stream. */
+    uint32_t maxFrameSize;
+
+    /** @param  corrupted : Set when an invalid length prefix was seen, cleared by reset(). */
+    mutable bool corrupted;
+
+    uint32_t headerLength() const;
+
+public:
+    static constexpr size_t HEADER_SIZE = 4;
+
+    explicit FrameDecoder(uint32_t a_maxFrameSize = 16 * 1024 * 1024);
+
+    char *prepare(size_t a_minSpace);
+    size_t writableSize() const;
+    void commit(size_t a_bytes);
+    void feed(const char *a_data, size_t a_length);
+
+    bool hasFrame() const;
+    size_t nextFrameLength() const;
+    bool nextFrame(const char *&a_data, size_t &a_length);
+    size_t bufferedBytes() const;
+    bool isCorrupted() const;
+    void reset();
+    uint32_t getMaxFrameSize() const { return maxFrameSize; }
+
+    static void encodeHeader(uint32_t a_payloadLength, char a_header[HEADER_SIZE]);
+};
+
+#endif // FRAMEDECODER_HPP
@@ -0,0 +1,104 @@
+#ifndef IOTHREAD_HPP
+#define IOTHREAD_HPP
+
+#include "Channel.hpp"
+#include "EventLoop.hpp"
+#include "SpscRing.hpp"
+#include "UDPSocket.hpp"
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+/*
+ ? IOThread:
+ * Decouples receiving from processing. One dedicated thread watches every attached channel with
+ * an EventLoop and drains its socket into that channel's Inbox, a lock-free SPSC ring of
+ * preallocated message slots, as soon as data arrives. A handler thread drains the Inbox at its
+ * own pace, so a slow handler never keeps the kernel receive buffer from being emptied
+ * (which is where UDP datagrams are dropped).
+ *
+ * When an Inbox is full its socket is no longer read (TCP: the sender is flow-controlled,
+ * UDP: the kernel buffer absorbs the burst) and reading resumes once the handler made room.
+ *
+ * Channels are attached before start(), a ServerChannel after its start() (accepted socket).
+ * Attached sockets are read with a zero receive deadline (never block); they must use the
+ * blocking backend since io_uring rings belong to the thread that created the socket.
+ * Sending through the channel from handler threads is unaffected. UDP sockets must not have
+ * GRO enabled: a coalesced buffer would arrive as one message.
+ */
+class IOThread
+{
+public:
+    /* One received message (or the end of the stream when status isn't OK)*/
+    struct Message
+    {
+        std::vector<char> data; /* maxMessageSize bytes, allocated once per slot*/
+        size_t length = 0;
+        SocketStatus status = SocketStatus::OK;
+        int errorNumber = 0;
+        struct sockaddr_in sender = {}; /* Datagram sockets only (reply with a UDPSocket to this address)*/
+    };
+
+    class Inbox
+    {
+    private:
+        friend class IOThread;
+
+        IOThread &owner;
+        Socket *socket;
+        SpscRing<Message> ring;
+
+        /** @param  datagrams : recvmmsg slots when the socket is a UDPSocket (nullptr for streams). */
+        std::unique_ptr<DatagramBatch> datagrams;
+
+        /** @param  paused : Set by the I/O thread when the ring filled up, the handler wakes it after a pop. */
+        std::atomic<bool> paused;
+
+        /** @param  closed : The stream ended (last message has a non-OK status), nothing more will arrive. */
+        std::atomic<bool> closed;
+
+        /** @param  readyFD : eventfd signalled for a handler sleeping in wait(). */
+        int readyFD;
+        std::atomic<bool> waiting;
+
+        Inbox(IOThread &a_owner, Socket *a_socket, size_t a_capacity, size_t a_maxMessageSize);
+
+    public:
+        Inbox(const Inbox &) = delete;
+        Inbox &operator=(const Inbox &) = delete;
+
+        /* Handler side (one thread per Inbox)*/
+        const Message *front();
+        void pop();
+        bool wait(int a_timeoutMs = -1);
+        size_t size() const;
+        bool isClosed() const;
+
+        ~Inbox();
+    };
+
+private:
+    EventLoop loop;
+    std::vector<std::unique_ptr<Inbox>> inboxes;
+    std::thread thread;
+    std::atomic<bool> running;
+
+    void drain(Inbox &a_inbox);
+    bool drainDatagrams(Inbox &a_inbox, bool &a_published);
+    void resumePaused();
+
+public:
+    IOThread();
+    IOThread(const IOThread &) = delete;
+    IOThread &operator=(const IOThread &) = delete;
+
+    Inbox &attach(Channel &a_channel, size_t a_capacity = 1024, size_t a_maxMessageSize = 2048);
+    void start();
+    void stop();
+
+    // Destructor for IOThread
+    ~IOThread();
+};
+
+#endif // IOTHREAD_HPP
@@ -0,0 +1,101 @@
+#ifndef IOURING_HPP
+#define IOURING_HPP
+
+#include <linux/io_uring.h> // For io_uring_params, io_uring_sqe and io_uring_cqe
+#include <sys/socket.h>
+#include <cstddef>
+#include <cstdint>
+
+/*
+ ? IOUring:
+ * Minimal io_uring wrapper built directly on the io_uring_setup/io_uring_enter system calls
+ * (no liburing dependency). Operations are prepared into the submission queue (SQ) without any
+ * system call and are handed to the kernel in batches by one io_uring_enter, which is also used
+ * to wait for completions (CQ).
+ *
+ * Every operation carries a Request pointer as user_data. When its completion is reaped the
+ * request's complete() is called with the result (bytes transferred, new fd, or -errno).
+ *
+ * An IOUring is not thread-safe: TCPSocket/UDPSocket use one ring per thread (threadRing()),
+ * so everything a thread queues is submitted together.
+ */
+class IOUring
+{
+public:
+    struct Request
+    {
+        int result = 0;
+        bool completed = false;
+
+        virtual void complete(int a_result)
+        {
+            result = a_result;
+            completed = true;
+        }
+        virtual ~Request() = default;
+    };
+
+private:
+    /** @param  ringFD : File descriptor returned by io_uring_setup (-1 when unavailable). */
+    int ringFD;
+
+    /** @param  sqRing / cqRing : Shared ring memory (the same mapping when IORING_FEAT_SINGLE_MMAP). */
+    void *sqRing;
+    void *cqRing;
+    size_t sqRingSize;
+    size_t cqRingSize;
+
+    /** @param  sqes : Submission queue entries array (separate mapping). */
+    struct io_uring_sqe *sqes;
+    size_t sqesSize;
+
+    unsigned *sqHead;
+    unsigned *sqTail;
+    unsigned *sqMask;
+    unsigned *sqArray;
+    unsigned sqEntries;
+
+    unsigned *cqHead;
+    unsigned *cqTail;
+    unsigned *cqMask;
+    struct io_uring_cqe *cqes;
+
+    /** @param  localTail : SQ tail including prepared entries not yet published to the kernel. */
+    unsigned localTail;
+
+    /** @param  inFlight : Operations submitted or prepared whose completion wasn't reaped yet. */
+    unsigned inFlight;
+
+    struct io_uring_sqe *nextSqe(int a_fd, uint8_t a_opcode, Request *a_request);
+    int enter(unsigned a_toSubmit, unsigned a_minComplete);
+    void cancel(Request &a_request, int a_error);
+
+public:
+    /** @param  SUBMIT_BATCH : Prepared operations after which sockets submit without waiting for a receive/flush. */
+    static constexpr unsigned SUBMIT_BATCH = 32;
+
+    explicit IOUring(unsigned a_entries = 256);
+    IOUring(const IOUring &) = delete;
+    IOUring &operator=(const IOUring &) = delete;
+
+    static IOUring &threadRing();
+
+    bool isReady() const;
+
+    void prepareSend(int a_fd, const void *a_buffer, size_t a_length, int a_flags, Request *a_request);
+    void prepareSendMsg(int a_fd, const struct msghdr *a_message, int a_flags, Request *a_request);
+    void prepareRecv(int a_fd, void *a_buffer, size_t a_length, int a_flags, Request *a_request);
+    void prepareRecvMsg(int a_fd, struct msghdr *a_message, int a_flags, Request *a_request);
+    void prepareAccept(int a_fd, struct sockaddr *a_address, socklen_t *a_addressLength, int a_flags, Request *a_request);
+
+    unsigned pendingSubmissions() const;
+    unsigned operationsInFlight() const;
+
+    int submit();
+    unsigned reapCompletions();
+    void waitFor(Request &a_request);
+
+    ~IOUring();
+};
+
+#endif // IOURING_HPP
@@ -0,0 +1,75 @@
+#ifndef LATENCYHISTOGRAM_HPP
+#define LATENCYHISTOGRAM_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/*
+ ? LatencyHistogram:
+ * High-dynamic-range histogram of latencies in nanoseconds (1 ns up to ~18 minutes).
+ * Every power of two is split into SUB_BUCKET_COUNT linear buckets, so a recorded value is
+ * off by less than 1/SUB_BUCKET_COUNT (< 0.8%) whatever its magnitude, with a fixed memory
+ * footprint and O(1) recording (a count-leading-zeros and a shift, no search, no allocation).
+ *
+ * It is a plain value: snapshots of different channels/threads are combined with merge(),
+ * and percentiles are answered from the bucket counts (min/max are exact).
+ * For recording on one thread while another thread reads, see LatencyRecorder.
+ */
+class LatencyHistogram
+{
+public:
+    static constexpr unsigned SUB_BUCKET_BITS = 7;
+    static constexpr size_t SUB_BUCKET_COUNT = size_t(1) << SUB_BUCKET_BITS;
+    static constexpr unsigned VALUE_BITS = 40;
+    static constexpr uint64_t HIGHEST_TRACKABLE = (uint64_t(1) << VALUE_BITS) - 1; /* Larger values are clamped (max() stays exact)*/
+    static constexpr size_t BUCKET_COUNT = (VALUE_BITS - SUB_BUCKET_BITS + 1) * SUB_BUCKET_COUNT;
+
+    static size_t bucketIndex(uint64_t a_value)
+    {
+        /*
+         ! Log-linear index:
+         * Below 2*SUB_BUCKET_COUNT every value has its own bucket. Above, the value is shifted
+         * right until it has SUB_BUCKET_BITS+1 significant bits (the mantissa, 128..255), and
+         * each shift moves one block of SUB_BUCKET_COUNT buckets further.
+         */
+        if (a_value > HIGHEST_TRACKABLE)
+        {
+            a_value = HIGHEST_TRACKABLE;
+        }
+        if (a_value < 2 * SUB_BUCKET_COUNT)
+        {
+            return (size_t)a_value;
+        }
+        unsigned shift = (63 - __builtin_clzll(a_value)) - SUB_BUCKET_BITS;
+        return shift * SUB_BUCKET_COUNT + (size_t)(a_value >> shift);
+    }
+    static uint64_t bucketLowest(size_t a_index);
+    static uint64_t bucketHighest(size_t a_index);
+
+private:
+    std::vector<uint64_t> counts;
+    uint64_t total;
+    uint64_t sum;
+    uint64_t minimum;
+    uint64_t maximum;
+
+    friend class LatencyRecorder;
+
+public:
+    LatencyHistogram();
+
+    void record(uint64_t a_nanoseconds, uint64_t a_count = 1);
+    void merge(const LatencyHistogram &a_other);
+    void reset();
+
+    uint64_t count() const { return total; }
+    uint64_t min() const { return total ? minimum : 0; }
+    uint64_t max() const { return maximum; }
+    double mean() const { return total ? (double)sum / total : 0.0; }
+
+    /* Smallest value that a_percent % of the recorded values are at or below (percentile(99.9) = p99.9)*/
+    uint64_t percentile(double a_percent) const;
+};
+
+#endif // LATENCYHISTOGRAM_HPP
@@ -0,0 +1,57 @@
+#ifndef LATENCYRECORDER_HPP
+#define LATENCYRECORDER_HPP
+
+#include "LatencyHistogram.hpp"
+#include <atomic>
+#include <memory>
+
+/*
+ ? LatencyRecorder:
+ * A LatencyHistogram that one thread records into while any other thread takes snapshots.
+ * There is a single writer, so record() is a relaxed load and store per field (no locked
+ * read-modify-write); a snapshot() taken concurrently may miss the record() in progress but
+ * never sees a torn counter.
+ *
+ * Snapshots are LatencyHistograms: one recorder per thread/channel, merged by the reader.
+ */
+class LatencyRecorder
+{
+private:
+    std::unique_ptr<std::atomic<uint64_t>[]> counts;
+    std::atomic<uint64_t> total;
+    std::atomic<uint64_t> sum;
+    std::atomic<uint64_t> minimum;
+    std::atomic<uint64_t> maximum;
+
+    static void increment(std::atomic<uint64_t> &a_value, uint64_t a_amount)
+    {
+        a_value.store(a_value.load(std::memory_order_relaxed) + a_amount, std::memory_order_relaxed);
+    }
+
+public:
+    LatencyRecorder();
+    LatencyRecorder(const LatencyRecorder &) = delete;
+    LatencyRecorder &operator=(const LatencyRecorder &) = delete;
+
+    /* Recording thread only*/
+    void record(uint64_t a_nanoseconds)
+    {
+        increment(counts[LatencyHistogram::bucketIndex(a_nanoseconds)], 1);
+        increment(total, 1);
+        increment(sum, a_nanoseconds);
+        if (a_nanoseconds < minimum.load(std::memory_order_relaxed))
+        {
+            minimum.store(a_nanoseconds, std::memory_order_relaxed);
+        }
+        if (a_nanoseconds > maximum.load(std::memory_order_relaxed))
+        {
+            maximum.store(a_nanoseconds, std::memory_order_relaxed);
+        }
+    }
+    void reset(); /* Recording thread only*/
+
+    /* Any thread*/
+    LatencyHistogram snapshot() const;
+};
+
+#endif // LATENCYRECORDER_HPP
@@ -0,0 +1,43 @@
+#ifndef MULTICASTGROUPS_HPP
+#define MULTICASTGROUPS_HPP
+
+#include <netinet/in.h> // For sockaddr_in
+#include <sys/socket.h> // For mmsghdr
+#include <sys/uio.h>    // For iovec
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/*
+ ? MulticastGroups:
+ * Destination list for UDPSocket::publish() / publishEach(). Every group gets its sockaddr_in
+ * and an mmsghdr addressed to it when it is added, so a publish to all groups is one sendmmsg
+ * call that only fills in the payload iovecs (no allocation, no address conversion per tick).
+ *
+ * Groups are addressed by the index add() returned, publishEach() sends payload i to group i.
+ */
+class MulticastGroups
+{
+private:
+    /** @param  destinations : Group address and port of every group. */
+    std::vector<struct sockaddr_in> destinations;
+
+    /** @param  headers / segments : Per-group sendmmsg bookkeeping (segments: publishEach payloads). */
+    std::vector<struct mmsghdr> headers;
+    std::vector<struct iovec> segments;
+
+    friend class UDPSocket;
+    void wire();
+
+public:
+    MulticastGroups() = default;
+    MulticastGroups(const MulticastGroups &) = delete;
+    MulticastGroups &operator=(const MulticastGroups &) = delete;
+
+    int add(const std::string &a_groupIP, int a_port); /* Index of the group, -1 when it isn't a multicast address*/
+    void clear();
+    size_t size() const;
+    const struct sockaddr_in &destination(size_t a_index) const;
+};
+
+#endif // MULTICASTGROUPS_HPP
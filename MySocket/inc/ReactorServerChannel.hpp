@@ -0,0 +1,108 @@
+#ifndef REACTORSERVERCHANNEL_HPP
+#define REACTORSERVERCHANNEL_HPP
+
+#include "Socket.hpp"
+#include "EventLoop.hpp"
+#include "SendQueue.hpp"
+#include <functional>
+#include <unordered_map>
+
+/*
+ ? ReactorServerChannel:
+ * Event-driven counterpart of ServerChannel for TCP. Instead of one blocking accept() and a
+ * single SocketToClient, the listening socket and every accepted connection are non-blocking
+ * and registered with an EventLoop, so one thread serves any number of clients.
+ *
+ * The application is notified through per-connection readiness callbacks:
+ *   onConnect    : a client was accepted and registered.
+ *   onReadable   : the connection has data (call receive() on the given socket, it won't block).
+ *   onDisconnect : the peer closed or the connection failed; the socket is deleted afterwards.
+ *
+ * Connections are identified by their file descriptor, which stays unique while they are open.
+ *
+ * Sends never block the loop. What a connection's socket buffer can't take is kept in a bounded
+ * per-connection SendQueue and written when epoll reports EPOLLOUT, a partly written message first.
+ * A slow consumer only fills its own queue:
+ *   onBackpressure(id, true)  : the queue reached the high watermark, send() refuses messages
+ *                               for that connection (WOULD_BLOCK, ENOBUFS) until...
+ *   onBackpressure(id, false) : ...it drained to the low watermark.
+ * Messages still queued when a connection closes are lost.
+ *
+ * Accepted connections have no send/receive deadlines (the listener's aren't inherited here),
+ * so a call made on the loop thread never waits.
+ */
+class ReactorServerChannel
+{
+public:
+    using ConnectionCallback = std::function<void(int a_connectionId, Socket &a_connection)>;
+    using BackpressureCallback = std::function<void(int a_connectionId, bool a_congested)>;
+
+    static constexpr size_t DEFAULT_LOW_WATERMARK = 64 * 1024;
+    static constexpr size_t DEFAULT_HIGH_WATERMARK = 1024 * 1024;
+    static constexpr uint64_t ACCEPT_RETRY_MS = 100; /* Listener pause after accept ran out of descriptors*/
+
+private:
+    /** @param  listenSocket : Listening socket (owned by the caller, like ServerChannel's socket). */
+    Socket *listenSocket;
+
+    /** @param  loop : Event loop that dispatches readiness for the listener and the connections. */
+    EventLoop &loop;
+
+    int port; /** Data member to store the port*/
+
+    const std::string ip; /** Data member to store the ip (unused for TCP, kept for symmetry with ServerChannel)*/
+
+    /** @param  connections : Accepted sockets (owned by the channel) keyed by connection id. */
+    std::unordered_map<int, Socket *> connections;
+
+    /** @param  closedStats : Counters of the connections already closed, so stats() keeps covering them. */
+    SocketCounters closedStats;
+
+    /** @param  sendQueues : Unsent output, only for connections whose socket buffer is full (EPOLLOUT armed). */
+    std::unordered_map<int, SendQueue> sendQueues;
+
+    size_t lowWatermark;
+    size_t highWatermark;
+
+    ConnectionCallback connectCallback;
+    ConnectionCallback readableCallback;
+    ConnectionCallback disconnectCallback;
+    BackpressureCallback backpressureCallback;
+
+    /** @param  acceptRetryTimer : Re-arms the paused listener (0: listener armed). */
+    EventLoop::TimerId acceptRetryTimer;
+
+    bool started;
+
+    void acceptPending();
+    void handleConnectionEvents(int a_connectionId, uint32_t a_events);
+    void flushQueue(int a_connectionId);
+
+public:
+    explicit ReactorServerChannel(Socket *a_listenSocket, EventLoop &a_loop, int a_port, const std::string a_ip = "", TuningProfile a_profile = TuningProfile::DEFAULT);
+
+    void onConnect(ConnectionCallback a_callback);
+    void onReadable(ConnectionCallback a_callback);
+    void onDisconnect(ConnectionCallback a_callback);
+    void onBackpressure(BackpressureCallback a_callback);
+    void setSendQueueLimits(size_t a_lowWatermark, size_t a_highWatermark); /* Bytes, for queues created afterwards*/
+
+    void setFraming(FramingType a_framing);
+    SocketResult start();
+    SocketResult send(int a_connectionId, const std::string &message);
+    SocketResult send(int a_connectionId, const MessageSegment *a_segments, size_t a_count);
+    void broadcast(const std::string &message);
+    size_t queuedBytes(int a_connectionId) const;
+    bool isCongested(int a_connectionId) const;
+    void close(int a_connectionId);
+    Socket *getConnection(int a_connectionId) const;
+    std::string getClientIP(int a_connectionId) const;
+    size_t connectionCount() const;
+    SocketCounters stats() const; /* Listener + open + closed connections; call from the loop thread*/
+    void stop();
+
+    // Destructor for ReactorServerChannel
+    ~ReactorServerChannel();
+};
+
+#endif // REACTORSERVERCHANNEL_HPP
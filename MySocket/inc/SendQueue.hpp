@@ -0,0 +1,58 @@
+#ifndef SENDQUEUE_HPP
+#define SENDQUEUE_HPP
+
+#include "Socket.hpp"
+#include "BufferPool.hpp"
+#include <deque>
+
+/*
+ ? SendQueue:
+ * Outgoing messages of one non-blocking connection that the socket buffer couldn't take yet.
+ * The message at the front may be partly written: it is resumed with Socket::sendRemaining(),
+ * so a frame is never cut (the peer would lose the framing of everything after it).
+ *
+ * The queue is bounded by two watermarks on the queued message bytes:
+ *   high : reached by push(), the queue is congested and refuses further messages.
+ *   low  : reached by flush() while congested, the queue accepts messages again.
+ * The gap between them keeps a producer from flapping on every message.
+ *
+ * Message bytes are copied into pool buffers (see BufferPool), once, when they are queued.
+ */
+class SendQueue
+{
+private:
+    struct Message
+    {
+        BufferPool::Buffer data;
+        size_t length;
+        size_t sentBytes; /* Already written, the frame header included*/
+    };
+
+    std::deque<Message> messages;
+
+    /** @param  queuedBytes : Bytes of the queued messages, the partly written one counted whole. */
+    size_t queuedBytes;
+
+    size_t lowWatermark;
+    size_t highWatermark;
+    bool congested;
+
+public:
+    explicit SendQueue(size_t a_lowWatermark, size_t a_highWatermark);
+    SendQueue(const SendQueue &) = delete;
+    SendQueue &operator=(const SendQueue &) = delete;
+    SendQueue(SendQueue &&) = default;
+
+    /* Queues the rest of a message, a_sentBytes of it were already written. false: congested, refused*/
+    bool push(const MessageSegment *a_segments, size_t a_count, size_t a_sentBytes = 0);
+
+    /* Writes queued messages until the socket blocks. OK: drained, WOULD_BLOCK: some left, otherwise the failure*/
+    SocketResult flush(Socket &a_socket);
+
+    bool empty() const { return messages.empty(); }
+    size_t size() const { return messages.size(); }
+    size_t bytes() const { return queuedBytes; }
+    bool isCongested() const { return congested; }
+};
+
+#endif // SENDQUEUE_HPP
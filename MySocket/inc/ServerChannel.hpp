@@ -17,10 +17,16 @@ private:
     Socket *SocketToClient; /* Store socket to client for TCP to send to*/
 
 public:
-    explicit ServerChannel(Socket *socket, int a_port, const std::string a_ip = "");
-    void start() override;
-    void send(const std::string &message) override;
+    explicit ServerChannel(Socket *socket, int a_port, const std::string a_ip = "", TuningProfile a_profile = TuningProfile::DEFAULT);
+    SocketResult start() override;
+    SocketResult send(const std::string &message) override;
+    SocketResult send(const MessageSegment *a_segments, size_t a_count) override;
     std::string receive();
+    SocketResult receive(char *a_buffer, size_t a_length) override;
+    void setFraming(FramingType a_framing) override;
+    void flush() override;
+    Socket *getSocket() const override;
+    SocketCounters stats() const override;
     std::string getClientIP() const;
     void stop() override;
     // Destructor for ServerChannel
@@ -0,0 +1,65 @@
+#ifndef SHARDEDSERVERCHANNEL_HPP
+#define SHARDEDSERVERCHANNEL_HPP
+
+#include "TCPSocket.hpp"
+#include "EventLoop.hpp"
+#include "ReactorServerChannel.hpp"
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+
+/*
+ ? ShardedServerChannel:
+ * Runs one ReactorServerChannel per worker thread, each with its own SO_REUSEPORT listener bound
+ * to the same port and its own EventLoop. The kernel spreads incoming connections across the
+ * listeners, and a worker accepts, reads and writes its connections end-to-end: no accept lock,
+ * no hand-off between threads, so accept and I/O throughput grow with the number of cores.
+ *
+ * The WorkerSetup callback is called once per worker (on the calling thread, before the workers
+ * run) to install the connection callbacks. Those callbacks then run on that worker's thread only.
+ * Listeners use the blocking backend (io_uring rings are per thread).
+ */
+class ShardedServerChannel
+{
+public:
+    using WorkerSetup = std::function<void(size_t a_workerIndex, EventLoop &a_loop, ReactorServerChannel &a_channel)>;
+
+private:
+    struct Worker
+    {
+        std::unique_ptr<TCPSocket> listenSocket;
+        std::unique_ptr<EventLoop> loop;
+        std::unique_ptr<ReactorServerChannel> channel;
+        std::thread thread;
+    };
+
+    int port; /** Data member to store the port*/
+
+    const std::string ip; /** Data member to store the ip (unused for TCP, kept for symmetry with ServerChannel)*/
+
+    /** @param  workerCount : Number of listener/loop/thread shards. */
+    size_t workerCount;
+
+    std::vector<Worker> workers;
+
+    /** @param  stoppedStats : Counters of every worker, summed by stop() before the workers are released. */
+    SocketCounters stoppedStats;
+
+    bool started;
+
+public:
+    explicit ShardedServerChannel(int a_port, size_t a_workerCount = std::thread::hardware_concurrency(), const std::string a_ip = "");
+    ShardedServerChannel(const ShardedServerChannel &) = delete;
+    ShardedServerChannel &operator=(const ShardedServerChannel &) = delete;
+
+    SocketResult start(WorkerSetup a_setup);
+    void stop();
+    size_t getWorkerCount() const;
+    SocketCounters stats() const; /* Totals as of the last stop(); while running, read ReactorServerChannel::stats() from a worker's own loop*/
+
+    // Destructor for ShardedServerChannel
+    ~ShardedServerChannel();
+};
+
+#endif // SHARDEDSERVERCHANNEL_HPP
@@ -10,20 +10,105 @@
 #include <iostream>
 #include <cstring>
 #include <unistd.h>
+#include <fcntl.h>      // For fcntl and O_NONBLOCK
+#include <poll.h>       // For poll
+#include <cerrno>
 #include <vector>
+#include "SocketResult.hpp"
+#include "SocketStats.hpp"
+#include "SocketTuning.hpp"
 
+/*
+ ? IOBackendType: selected when a TCPSocket/UDPSocket is constructed.
+ * BLOCKING : one send/recv system call per operation (default).
+ * IO_URING : operations are queued on the calling thread's io_uring and submitted in batches,
+ *            send() only queues; a receive(), flush() or shutdown() (or a full batch) submits.
+ */
+enum class IOBackendType
+{
+    BLOCKING,
+    IO_URING
+};
+
+/*
+ ? FramingType: how message boundaries are kept on a stream socket.
+ * RAW             : receive() returns whatever one read returned (default, datagram sockets are always RAW).
+ * LENGTH_PREFIXED : every send() is one frame [4-byte big-endian length][payload] and receive()
+ *                   returns exactly one frame (see FrameDecoder).
+ */
+enum class FramingType
+{
+    RAW,
+    LENGTH_PREFIXED
+};
+
+/*
+ ? MessageSegment: one piece of a logical message (e.g. protocol header, payload).
+ * send(segments, count) hands all pieces to the kernel in one sendmsg call (scatter-gather),
+ * so a header and a payload never have to be concatenated into a new buffer first.
+ */
+struct MessageSegment
+{
+    const void *data;
+    size_t length;
+};
+
+/*
+ ? Error handling:
+ * Operations that can fail return a SocketResult (OK, WOULD_BLOCK, TIMEOUT, PEER_CLOSED, ERROR)
+ * instead of printing, and none of them blocks longer than the deadline set with setTimeouts().
+ * In non-blocking mode without a deadline they return WOULD_BLOCK instead of waiting.
+ */
 // Abstract Class: Socket
 class Socket
 {
+protected:
+    /** @param  statistics : Hot-path counters, updated by the send/receive paths of the derived sockets. */
+    SocketStats statistics;
+
 public:
     virtual const struct sockaddr_in* getAddress() const = 0;
-    virtual void connect(const std::string &a_ip, int a_port) = 0;
-    virtual void bind(const std::string &a_ip, int a_port) = 0;
-    virtual void listen(int backlog =5) = 0;
-    virtual Socket* accept() = 0;
-    virtual void send(const std::string &message) = 0;
-    virtual std::string receive() = 0;
+    virtual int getFD() const = 0;
+    virtual SocketResult setNonBlocking(bool a_nonBlocking) = 0;
+    virtual void setTimeouts(const SocketTimeouts &a_timeouts) = 0;
+    virtual SocketTimeouts getTimeouts() const = 0;
+    /* Applies a set of socket options (see SocketTuning), accepted sockets inherit it*/
+    virtual SocketResult setTuning(const SocketTuning &a_tuning)
+    {
+        return SocketResult(SocketStatus::ERROR, 0, EOPNOTSUPP);
+    }
+    virtual SocketTuning getTuning() const { return SocketTuning(); }
+    /* Busy-poll receive mode: blocking receives spin up to a_spinBudgetUs before they sleep (0: off)*/
+    virtual SocketResult setBusyPoll(int a_spinBudgetUs)
+    {
+        return SocketResult(SocketStatus::ERROR, 0, EOPNOTSUPP);
+    }
+    virtual SocketResult connect(const std::string &a_ip, int a_port) = 0;
+    virtual SocketResult bind(const std::string &a_ip, int a_port) = 0;
+    virtual SocketResult listen(int backlog =5) = 0;
+    virtual Socket* accept() = 0; /* nullptr when nothing is pending (non-blocking) or on error (errno set)*/
+    virtual SocketResult send(const std::string &message) = 0;
+    virtual SocketResult send(const MessageSegment *a_segments, size_t a_count) = 0; /* One message (one datagram for UDP)*/
+    /* Continues a message whose send returned WOULD_BLOCK after a_sentBytes (header included), same segments*/
+    virtual SocketResult sendRemaining(const MessageSegment *a_segments, size_t a_count, size_t a_sentBytes)
+    {
+        return a_sentBytes == 0 ? send(a_segments, a_count) : SocketResult::fromErrno(EINVAL);
+    }
+    virtual std::string receive() = 0; /* Empty string when nothing was received, use receive(std::string&) for the reason*/
+    virtual SocketResult receive(std::string &a_message) = 0;
+    /* Receives into caller-owned memory, result.bytes is the number of bytes received*/
+    virtual SocketResult receive(char *a_buffer, size_t a_length) = 0;
+    /* Zero-copy receive: a_data points at the message inside the socket's own buffer, valid until the next receive on this socket*/
+    virtual SocketResult receiveView(const char *&a_data, size_t &a_length)
+    {
+        return SocketResult(SocketStatus::ERROR, 0, EOPNOTSUPP);
+    }
+    virtual void setFraming(FramingType a_framing) {} /* Only meaningful for stream sockets*/
+    virtual bool hasPendingMessage() const { return false; } /* A complete message is already buffered (receive() won't read)*/
+    virtual void flush() {} /* Hands queued operations to the kernel (no-op for the blocking backend)*/
     virtual void shutdown() = 0;
+    SocketCounters stats() const { return statistics.snapshot(); } /* Sums the per-thread slots (see SocketStats)*/
+    void resetStats() { statistics.reset(); }
     virtual ~Socket() = default;
 };
 
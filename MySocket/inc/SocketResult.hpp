@@ -0,0 +1,107 @@
+#ifndef SOCKETRESULT_HPP
+#define SOCKETRESULT_HPP
+
+#include <chrono>
+#include <cstddef>
+
+/*
+ ? SocketStatus: outcome of a socket operation.
+ * OK          : the operation completed (bytes says how much was transferred).
+ * WOULD_BLOCK : non-blocking socket without a deadline and nothing could be done right now,
+ *               retry when epoll reports the descriptor ready (bytes may be partial for a send).
+ * TIMEOUT     : the connect/send/receive deadline (see SocketTimeouts) expired first.
+ * PEER_CLOSED : orderly close (recv returned 0) or the connection was reset/broken (EPIPE, ECONNRESET).
+ * ERROR       : anything else, errorNumber holds the errno value.
+ */
+enum class SocketStatus
+{
+    OK,
+    WOULD_BLOCK,
+    TIMEOUT,
+    PEER_CLOSED,
+    ERROR
+};
+
+/*
+ ? SocketResult:
+ * Returned by every socket/channel operation that can fail instead of printing to std::cerr,
+ * so the caller decides whether to retry, drop the device or report the failure.
+ */
+struct SocketResult
+{
+    /** @param  status : What happened (see SocketStatus). */
+    SocketStatus status;
+
+    /** @param  bytes : Bytes transferred (datagrams for UDPSocket::receiveBatch), also set on a partial send. */
+    size_t bytes;
+
+    /** @param  errorNumber : errno of the failure, 0 when status is OK. */
+    int errorNumber;
+
+    SocketResult(SocketStatus a_status = SocketStatus::OK, size_t a_bytes = 0, int a_errorNumber = 0)
+        : status(a_status), bytes(a_bytes), errorNumber(a_errorNumber) {}
+
+    bool ok() const { return status == SocketStatus::OK; }
+    explicit operator bool() const { return ok(); }
+
+    static SocketResult success(size_t a_bytes = 0) { return SocketResult(SocketStatus::OK, a_bytes, 0); }
+    static SocketResult fromErrno(int a_errorNumber, size_t a_bytes = 0);
+
+    /* Human readable text for logs ("Timed out", "Connection refused"...)*/
+    const char *describe() const;
+};
+
+/*
+ ? SocketTimeouts: per-operation deadlines in milliseconds, -1 means no deadline.
+ * A deadline covers the whole operation (e.g. every partial write of one send), not each system call.
+ */
+struct SocketTimeouts
+{
+    int connectMs = -1;
+    int sendMs = -1;
+    int receiveMs = -1;
+};
+
+/*
+ ? Deadline:
+ * A point on the monotonic clock computed once per operation. waitUntilReady() polls the descriptor
+ * for the remaining time only, so retries after EINTR or a partial write never extend the deadline.
+ */
+class Deadline
+{
+private:
+    bool infinite;
+    std::chrono::steady_clock::time_point expiry;
+
+public:
+    explicit Deadline(int a_timeoutMs);
+
+    bool isInfinite() const;
+    int remainingMs() const;
+
+    /* OK once a_fd reports a_events (or POLLERR/POLLHUP), TIMEOUT at expiry*/
+    SocketResult waitUntilReady(int a_fd, short a_events) const;
+};
+
+/*
+ ? SpinBudget:
+ * Bounds the busy-poll receive mode (see Socket::setBusyPoll): while it is spinning a receive
+ * retries non-blocking calls instead of sleeping, once the budget is used up it falls back to
+ * the normal blocking wait. A budget of 0 never spins.
+ */
+class SpinBudget
+{
+private:
+    bool spinning;
+    std::chrono::steady_clock::time_point expiry;
+
+public:
+    explicit SpinBudget(int a_budgetUs);
+
+    bool isSpinning() const { return spinning; }
+
+    /* Yields the CPU once and returns true while budget is left, false (for good) once it is used up*/
+    bool keepSpinning();
+};
+
+#endif // SOCKETRESULT_HPP
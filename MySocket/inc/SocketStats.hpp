@@ -0,0 +1,111 @@
+#ifndef SOCKETSTATS_HPP
+#define SOCKETSTATS_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+/*
+ ? SocketCounters: a snapshot of the counters of one socket (or the sum over a channel's sockets).
+ */
+struct SocketCounters
+{
+    uint64_t bytesIn = 0;
+    uint64_t bytesOut = 0;
+    uint64_t messagesIn = 0;         /* Frames, reads (RAW streams) or datagrams returned to the caller*/
+    uint64_t messagesOut = 0;        /* Messages/datagrams fully handed to the kernel (or queued on io_uring)*/
+    uint64_t syscalls = 0;           /* send/recv family calls (io_uring submissions are per thread, not counted)*/
+    uint64_t shortReads = 0;         /* A read returned less than the space offered*/
+    uint64_t shortWrites = 0;        /* A send took only part of the data (the rest followed)*/
+    uint64_t wouldBlocks = 0;        /* EAGAIN: nothing to read / no room to write*/
+    uint64_t errors = 0;             /* Failed calls other than EAGAIN and EINTR*/
+    uint64_t truncatedDatagrams = 0; /* Datagrams longer than the receive buffer (the rest was discarded)*/
+    uint64_t spinReceives = 0;       /* Busy-poll mode: receives served while spinning, no sleep/wakeup*/
+    uint64_t spinFallbacks = 0;      /* Busy-poll mode: the spin budget ran out, the receive blocked*/
+
+    SocketCounters &operator+=(const SocketCounters &a_other);
+    SocketCounters &operator-=(const SocketCounters &a_other); /* Traffic since an earlier snapshot of the same socket*/
+};
+
+/*
+ ? SocketStats:
+ * Hot-path counters of one socket. Every thread that touches the socket owns a slot of its own
+ * (cache-line aligned, allocated on its first count), so the I/O thread and a handler thread never
+ * bounce a cache line between them. Only the owner writes a slot, so an increment is a relaxed
+ * load and store, no locked read-modify-write. Nothing is summed until snapshot() is called,
+ * which is the only cost of reading them.
+ *
+ * A thread index is handed back when its thread exits and reused by a later thread, which then
+ * owns that slot. Past MAX_OWNED_SLOTS live threads the rest share one slot (atomic adds).
+ */
+class SocketStats
+{
+public:
+    enum Counter
+    {
+        BYTES_IN,
+        BYTES_OUT,
+        MESSAGES_IN,
+        MESSAGES_OUT,
+        SYSCALLS,
+        SHORT_READS,
+        SHORT_WRITES,
+        WOULD_BLOCKS,
+        ERRORS,
+        TRUNCATED_DATAGRAMS,
+        SPIN_RECEIVES,
+        SPIN_FALLBACKS,
+        COUNTER_COUNT
+    };
+
+    static constexpr size_t MAX_OWNED_SLOTS = 64;
+
+private:
+    struct alignas(64) Slot
+    {
+        std::atomic<uint64_t> values[COUNTER_COUNT];
+    };
+
+    /** @param  owned : Slot of each thread index, published by its owner (nullptr until it counts). */
+    std::atomic<Slot *> owned[MAX_OWNED_SLOTS];
+
+    /** @param  shared : Threads without an index of their own. */
+    Slot shared;
+
+    static constexpr size_t UNASSIGNED = ~size_t(0);
+
+    /** @param  threadIndex : Index of the calling thread, MAX_OWNED_SLOTS or more: the shared slot. */
+    static inline thread_local size_t threadIndex = UNASSIGNED;
+
+    static size_t assignThreadIndex();
+    Slot *claimSlot(size_t a_index);
+
+public:
+    SocketStats();
+    SocketStats(const SocketStats &) = delete;
+    SocketStats &operator=(const SocketStats &) = delete;
+
+    void add(Counter a_counter, uint64_t a_amount = 1)
+    {
+        size_t index = (threadIndex != UNASSIGNED) ? threadIndex : assignThreadIndex();
+        if (index >= MAX_OWNED_SLOTS)
+        {
+            shared.values[a_counter].fetch_add(a_amount, std::memory_order_relaxed);
+            return;
+        }
+        Slot *slot = owned[index].load(std::memory_order_relaxed);
+        if (slot == nullptr)
+        {
+            slot = claimSlot(index);
+        }
+        std::atomic<uint64_t> &value = slot->values[a_counter];
+        value.store(value.load(std::memory_order_relaxed) + a_amount, std::memory_order_relaxed);
+    }
+
+    SocketCounters snapshot() const;
+    void reset(); /* While no thread counts, an increment racing with it may survive*/
+
+    ~SocketStats();
+};
+
+#endif // SOCKETSTATS_HPP
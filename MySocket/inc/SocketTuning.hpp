@@ -0,0 +1,56 @@
+#ifndef SOCKETTUNING_HPP
+#define SOCKETTUNING_HPP
+
+#include "SocketResult.hpp"
+
+/*
+ ? TuningProfile: named sets of socket options, see SocketTuning::forProfile().
+ * DEFAULT         : kernel defaults, nothing is set.
+ * LOW_LATENCY     : small request/response (commands, acks). TCP_NODELAY, busy polling on
+ *                   receive, SO_PRIORITY 6 and IPTOS_LOWDELAY so the packets jump local queues.
+ * BULK_THROUGHPUT : streams and batched uploads. 4 MiB socket buffers, TCP_CORK so the kernel
+ *                   only sends full segments (flush() pushes the tail out), IPTOS_THROUGHPUT.
+ * LOW_MEMORY      : many idle devices on a small gateway. 16 KiB socket buffers, per-connection
+ *                   kernel memory stays small at the cost of throughput on a busy connection.
+ */
+enum class TuningProfile
+{
+    DEFAULT,
+    LOW_LATENCY,
+    BULK_THROUGHPUT,
+    LOW_MEMORY
+};
+
+/*
+ ? SocketTuning:
+ * Socket options applied by Socket::setTuning() (and inherited by accepted sockets, like the
+ * timeouts). A zero/negative field leaves the kernel default. TCP-only options are ignored for UDP.
+ *
+ * Options that need CAP_NET_ADMIN degrade: buffer sizes are forced past net.core.[rw]mem_max when
+ * allowed (SO_SNDBUFFORCE) and clamped to it otherwise, SO_PRIORITY above 6 is skipped. Raising
+ * SO_BUSY_POLL is refused without it and reported (EPERM), the other options are still set.
+ *
+ * Applied over an earlier tuning, the options it enabled that this one leaves off are cleared
+ * (TCP_NODELAY, TCP_CORK, SO_BUSY_POLL, SO_PRIORITY, IP_TOS). Buffer sizes stay: once set, the
+ * kernel no longer auto-tunes them, there is no way back to the default.
+ */
+struct SocketTuning
+{
+    int sendBufferBytes = 0;    /* SO_SNDBUF (the kernel doubles it for bookkeeping)*/
+    int receiveBufferBytes = 0; /* SO_RCVBUF*/
+    bool noDelay = false;       /* TCP_NODELAY: small writes leave at once instead of waiting for an ack (Nagle)*/
+    bool cork = false;          /* TCP_CORK: only full segments leave until flush(), at most 200 ms late*/
+    int busyPollUs = 0;         /* SO_BUSY_POLL: a blocking receive spins on the device queue this long*/
+    int priority = -1;          /* SO_PRIORITY: queueing discipline band (0..6 unprivileged)*/
+    int typeOfService = -1;     /* IP_TOS: DSCP/ToS byte, e.g. IPTOS_LOWDELAY*/
+
+    static SocketTuning forProfile(TuningProfile a_profile);
+
+    bool isDefault() const;
+
+    /* Sets every configured option on a_fd (clearing those of a_previous), returns the first failure (the others are still set)*/
+    SocketResult apply(int a_fd, bool a_stream, const SocketTuning &a_previous) const;
+    SocketResult apply(int a_fd, bool a_stream) const;
+};
+
+#endif // SOCKETTUNING_HPP
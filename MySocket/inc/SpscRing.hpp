@@ -0,0 +1,136 @@
+#ifndef SPSCRING_HPP
+#define SPSCRING_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+/*
+ ? SpscRing<T>:
+ * Bounded lock-free queue for exactly one producer thread and one consumer thread.
+ * The slots are constructed once, up front: the producer fills a slot in place (claim/publish)
+ * and the consumer reads it in place (front/consume), so nothing is allocated or copied per item
+ * beyond what the caller does with the slot.
+ *
+ ~ head (consumer) and tail (producer) live on separate cache lines, each next to the side's
+ ~ cached copy of the other index, so the two threads only exchange a cache line when the
+ ~ cached view says the ring looks full (producer) or empty (consumer).
+ *
+ * The capacity is rounded up to a power of two so the slot index is a mask, not a division.
+ */
+template <typename T>
+class SpscRing
+{
+private:
+    static constexpr size_t CACHE_LINE = 64;
+
+    std::vector<T> slots;
+    size_t mask;
+
+    /* Consumer side*/
+    alignas(CACHE_LINE) std::atomic<size_t> head;
+    size_t cachedTail;
+
+    /* Producer side*/
+    alignas(CACHE_LINE) std::atomic<size_t> tail;
+    size_t cachedHead;
+
+    /* Keeps whatever follows the ring in memory off the producer's line*/
+    char padding[CACHE_LINE - sizeof(std::atomic<size_t>) - sizeof(size_t)];
+
+    static size_t roundUp(size_t a_capacity)
+    {
+        size_t capacity = 2;
+        while (capacity < a_capacity)
+        {
+            capacity <<= 1;
+        }
+        return capacity;
+    }
+
+public:
+    explicit SpscRing(size_t a_capacity)
+        : slots(roundUp(a_capacity)), mask(roundUp(a_capacity) - 1), head(0), cachedTail(0), tail(0), cachedHead(0) {}
+    SpscRing(const SpscRing &) = delete;
+    SpscRing &operator=(const SpscRing &) = delete;
+
+    size_t capacity() const { return mask + 1; }
+
+    /* Approximate when called while the other side is running*/
+    size_t size() const { return tail.load(std::memory_order_acquire) - head.load(std::memory_order_acquire); }
+    bool empty() const { return size() == 0; }
+    bool full() const { return size() > mask; }
+
+    /* Direct access to every slot (e.g. to preallocate buffers before the threads start)*/
+    T &slot(size_t a_index) { return slots[a_index & mask]; }
+
+    /*
+     ! Producer: claim() returns the next free slot (nullptr when full), publish() hands it over.
+     */
+    T *claim()
+    {
+        size_t position = tail.load(std::memory_order_relaxed);
+        if (position - cachedHead > mask)
+        {
+            cachedHead = head.load(std::memory_order_acquire);
+            if (position - cachedHead > mask)
+            {
+                return nullptr;
+            }
+        }
+        return &slots[position & mask];
+    }
+
+    void publish()
+    {
+        tail.store(tail.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    bool push(const T &a_item)
+    {
+        T *target = claim();
+        if (target == nullptr)
+        {
+            return false;
+        }
+        *target = a_item;
+        publish();
+        return true;
+    }
+
+    /*
+     ! Consumer: front() returns the oldest published slot (nullptr when empty), consume() frees it.
+     */
+    T *front()
+    {
+        size_t position = head.load(std::memory_order_relaxed);
+        if (position == cachedTail)
+        {
+            cachedTail = tail.load(std::memory_order_acquire);
+            if (position == cachedTail)
+            {
+                return nullptr;
+            }
+        }
+        return &slots[position & mask];
+    }
+
+    void consume()
+    {
+        head.store(head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    bool pop(T &a_item)
+    {
+        T *source = front();
+        if (source == nullptr)
+        {
+            return false;
+        }
+        a_item = std::move(*source);
+        consume();
+        return true;
+    }
+};
+
+#endif // SPSCRING_HPP
@@ -2,25 +2,100 @@
 #define TCPSOCKET_HPP
 
 #include "Socket.hpp"
+#include "IOUring.hpp"
+#include "FrameDecoder.hpp"
+#include "ZeroCopyTracker.hpp"
+#include "BufferPool.hpp"
+#include <algorithm>
+#include <netinet/tcp.h> // For TCP_FASTOPEN and TCP_FASTOPEN_CONNECT
+
+#ifndef TCP_FASTOPEN_CONNECT
+#define TCP_FASTOPEN_CONNECT 30 /* Linux 4.11+, missing from older libc headers*/
+#endif
 
 class TCPSocket : public Socket
 {
 private:
     int sock; // Socket file descriptor
     struct sockaddr_in address; // Structure for address details
+    bool nonBlocking = false; // O_NONBLOCK set on the descriptor (inherited by accepted sockets)
+    IOBackendType backend; // Blocking system calls or io_uring batches (inherited by accepted sockets)
+    FramingType framing = FramingType::RAW; // Message boundaries on the stream (inherited by accepted sockets)
+    FrameDecoder decoder; // Reassembles LENGTH_PREFIXED frames across reads
+    BufferPool::Buffer viewBuffer; // RAW receiveView() target, taken from the pool on first use
+    bool zeroCopy = false; // SO_ZEROCOPY enabled, sendZeroCopy() uses MSG_ZEROCOPY
+    ZeroCopyTracker zeroCopyTracker; // Buffers the kernel still transmits from
+    SocketTimeouts timeouts; // Connect/send/receive deadlines (inherited by accepted sockets)
+    SocketTuning tuning; // Socket options of the profile (inherited by accepted sockets)
+    int busyPollBudgetUs = 0; // Spin budget of blocking receives, 0: off (inherited by accepted sockets)
+
+    /*
+     * io_uring send path: at most one send is in flight per socket so the byte stream stays ordered.
+     * Messages sent meanwhile are appended to pendingOutput and go out as one send when it completes.
+     */
+    struct UringSendRequest : IOUring::Request
+    {
+        TCPSocket *owner = nullptr;
+        std::string data;
+        size_t offset = 0;
+        void complete(int a_result) override;
+    };
+    IOUring *ring = nullptr;       // Thread ring used by the IO_URING backend
+    UringSendRequest sendRequest;  // The in-flight send (embedded, no allocation per message)
+    std::string pendingOutput;     // Bytes queued behind the in-flight send
+    bool sendInFlight = false;
+    int uringSendError = 0;        // errno of a failed queued send, reported by the next send()
 
-    explicit TCPSocket(int a_clientSock, struct sockaddr_in a_address);
+    explicit TCPSocket(int a_clientSock, struct sockaddr_in a_address, bool a_nonBlocking = false, IOBackendType a_backend = IOBackendType::BLOCKING);
+    void initBackend(IOBackendType a_backend);
+    void queueNextSend();
+    SocketResult socketClosed() const;
+    bool fitsFrame(size_t a_messageLength) const;
+    SocketResult sendSegments(struct iovec *a_segments, size_t a_count);
+    SocketResult sendMessage(const MessageSegment *a_segments, size_t a_count, size_t a_skipBytes);
+    SocketResult recvBytes(char *a_buffer, size_t a_length, int a_flags = 0);
+    SocketResult fillDecoder();
+    SocketResult awaitFrame();
 
 public:
-    TCPSocket();
+    explicit TCPSocket(IOBackendType a_backend = IOBackendType::BLOCKING);
+    TCPSocket(const TCPSocket &) = delete;
+    TCPSocket &operator=(const TCPSocket &) = delete;
     const struct sockaddr_in* getAddress() const override;
-    void connect(const std::string &a_ip, int a_port) override;
-    void bind(const std::string &a_ip, int a_port) override;
-    void listen(int backlog = 5) override;
+    int getFD() const override;
+    SocketResult setNonBlocking(bool a_nonBlocking) override;
+    void setTimeouts(const SocketTimeouts &a_timeouts) override;
+    SocketTimeouts getTimeouts() const override;
+    SocketResult setTuning(const SocketTuning &a_tuning) override;
+    SocketTuning getTuning() const override;
+    SocketResult setBusyPoll(int a_spinBudgetUs) override;
+    SocketResult connect(const std::string &a_ip, int a_port) override;
+    SocketResult bind(const std::string &a_ip, int a_port) override;
+    SocketResult listen(int backlog = 5) override;
     Socket* accept() override;
-    void send(const std::string &message) override;
+    SocketResult send(const std::string &message) override;
+    SocketResult send(const MessageSegment *a_segments, size_t a_count) override;
+    SocketResult sendRemaining(const MessageSegment *a_segments, size_t a_count, size_t a_sentBytes) override;
     std::string receive() override;
+    SocketResult receive(std::string &a_message) override;
+    SocketResult receive(char *a_buffer, size_t a_length) override;
+    SocketResult receiveView(const char *&a_data, size_t &a_length) override;
+    SocketResult setReuseAddress(bool a_enable);
+    SocketResult setReusePort(bool a_enable);
+    SocketResult enableFastOpen(int a_queueLength);
+    SocketResult enableFastOpenConnect();
+    bool isReusable() const;
+    bool enableZeroCopy();
+    SocketResult sendZeroCopy(const void *a_data, size_t a_length, ZeroCopyTracker::ReleaseCallback a_release, size_t a_sentBytes = 0);
+    size_t pollZeroCopyCompletions();
+    bool waitZeroCopyCompletions(int a_timeoutMs = -1);
+    size_t pendingZeroCopyBuffers() const;
+    size_t zeroCopyFallbacks() const;
+    void setFraming(FramingType a_framing) override;
+    bool hasPendingMessage() const override;
+    void flush() override;
     void shutdown() override;
+    ~TCPSocket();
 };
 
 #endif // TCPSOCKET_HPP
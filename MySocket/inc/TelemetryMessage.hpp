@@ -0,0 +1,113 @@
+#ifndef TELEMETRYMESSAGE_HPP
+#define TELEMETRYMESSAGE_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+/*
+ ? Compact binary telemetry format (version 1), all integers big-endian (network order):
+ *
+ *   Header (20 bytes)
+ *     0  uint8   version        TelemetryMessage::VERSION
+ *     1  uint8   type           TelemetryType
+ *     2  uint16  readingCount   Readings that follow the header
+ *     4  uint32  deviceId
+ *     8  uint32  sequence       Per device, incremented by the sender (gaps = lost messages)
+ *    12  uint64  timestampUs    Microseconds since the Unix epoch, taken by the sender
+ *
+ *   Reading (12 bytes, readingCount times)
+ *     0  uint16  sensorId
+ *     2  uint8   valueType      TelemetryValueType
+ *     3  uint8   unit           TelemetryUnit
+ *     4  64 bits value          int64 / uint64 / IEEE-754 double, as valueType says
+ *
+ * A message is one datagram (UDP) or one frame (TCP with LENGTH_PREFIXED framing). It is sent
+ * with Socket::send(const MessageSegment*, size_t) and received with Socket::receive(char*, size_t)
+ * or Socket::receiveView(), which carry any bytes (NUL included) and don't allocate.
+ */
+enum class TelemetryType : uint8_t
+{
+    READINGS = 1,  /* Sensor readings*/
+    HEARTBEAT = 2, /* Liveness, usually without readings (e.g. uptime as a reading)*/
+    COMMAND = 3,   /* Server to device, readings carry the arguments*/
+    ACK = 4        /* Reply to a COMMAND, same sequence*/
+};
+
+enum class TelemetryValueType : uint8_t
+{
+    INT64 = 1,
+    UINT64 = 2,
+    FLOAT64 = 3,
+    BOOL = 4 /* Encoded as the integer 0 or 1*/
+};
+
+enum class TelemetryUnit : uint8_t
+{
+    NONE = 0,
+    CELSIUS = 1,
+    PERCENT = 2,
+    PASCAL = 3,
+    VOLT = 4,
+    AMPERE = 5,
+    SECOND = 6
+};
+
+struct TelemetryHeader
+{
+    TelemetryType type = TelemetryType::READINGS;
+    uint16_t readingCount = 0;
+    uint32_t deviceId = 0;
+    uint32_t sequence = 0;
+    uint64_t timestampUs = 0;
+};
+
+struct TelemetryReading
+{
+    uint16_t sensorId = 0;
+    TelemetryValueType valueType = TelemetryValueType::INT64;
+    TelemetryUnit unit = TelemetryUnit::NONE;
+    union
+    {
+        int64_t integer;
+        uint64_t unsignedInteger;
+        double real;
+    };
+
+    TelemetryReading() : integer(0) {}
+    static TelemetryReading fromInteger(uint16_t a_sensorId, int64_t a_value, TelemetryUnit a_unit = TelemetryUnit::NONE);
+    static TelemetryReading fromUnsigned(uint16_t a_sensorId, uint64_t a_value, TelemetryUnit a_unit = TelemetryUnit::NONE);
+    static TelemetryReading fromReal(uint16_t a_sensorId, double a_value, TelemetryUnit a_unit = TelemetryUnit::NONE);
+    static TelemetryReading fromBool(uint16_t a_sensorId, bool a_value);
+};
+
+/*
+ ? TelemetryMessage: encoder/decoder for the format above.
+ * Everything works on caller-provided memory: encode() writes into a buffer, decodeHeader() and
+ * decodeReading() read from the received bytes. Nothing allocates and nothing throws, a buffer
+ * that is too small or a message that is malformed is reported by the return value.
+ * To read fields in place without decoding into structs, see TelemetryView.
+ */
+class TelemetryMessage
+{
+public:
+    static constexpr uint8_t VERSION = 1;
+    static constexpr size_t HEADER_SIZE = 20;
+    static constexpr size_t READING_SIZE = 12;
+    static constexpr size_t MAX_READINGS = (65507 - HEADER_SIZE) / READING_SIZE; /* Fits one UDP datagram*/
+
+    static size_t encodedSize(size_t a_readingCount) { return HEADER_SIZE + a_readingCount * READING_SIZE; }
+
+    /* Bytes written, 0 if a_capacity is too small or there are more than MAX_READINGS (a_header.readingCount is ignored)*/
+    static size_t encode(const TelemetryHeader &a_header, const TelemetryReading *a_readings, size_t a_readingCount,
+                         char *a_buffer, size_t a_capacity);
+
+    /* false: not a version 1 message, unknown type, or shorter than its readingCount says*/
+    static bool decodeHeader(const char *a_data, size_t a_length, TelemetryHeader &a_header);
+
+    /* Reading a_index of a message whose header decoded; false if it is out of range or has an unknown type*/
+    static bool decodeReading(const char *a_data, size_t a_length, size_t a_index, TelemetryReading &a_reading);
+
+    static uint64_t nowMicroseconds(); /* Wall clock for timestampUs*/
+};
+
+#endif // TELEMETRYMESSAGE_HPP
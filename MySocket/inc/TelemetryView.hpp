@@ -0,0 +1,115 @@
+#ifndef TELEMETRYVIEW_HPP
+#define TELEMETRYVIEW_HPP
+
+#include "TelemetryMessage.hpp"
+#include "ByteOrder.hpp"
+
+/*
+ ? TelemetryView:
+ * Read-only view of a telemetry message (format in TelemetryMessage.hpp) where it was received:
+ * a UDPSocket/TCPSocket receiveView() buffer, a DatagramBatch slot or a frame. Every accessor
+ * reads its field straight from those bytes (big-endian to host order), nothing is copied into
+ * an intermediate object and nothing is allocated.
+ *
+ * Bounds are checked once, by the constructor: valid() is false for anything that isn't a
+ * complete version 1 message, and the accessors of an invalid view return 0. reading(i) returns
+ * an invalid Reading when i is out of range or the reading has an unknown value type.
+ *
+ * The view doesn't own the bytes: it is valid as long as the buffer is (for receiveView(),
+ * until the next receive on that socket).
+ *
+ *   const char *data; size_t length;
+ *   if (socket.receiveView(data, length).ok())
+ *   {
+ *       TelemetryView message(data, length);
+ *       for (size_t i = 0; message.valid() && i < message.readingCount(); i++)
+ *       {
+ *           double celsius = message.reading(i).asReal();
+ *       }
+ *   }
+ */
+class TelemetryView
+{
+public:
+    class Reading
+    {
+    private:
+        const char *at; /* nullptr: invalid*/
+
+    public:
+        explicit Reading(const char *a_at = nullptr) : at(a_at) {}
+
+        bool valid() const { return at != nullptr; }
+        uint16_t sensorId() const { return at ? loadBigEndian16(at) : 0; }
+        TelemetryValueType valueType() const { return at ? (TelemetryValueType)(uint8_t)at[2] : TelemetryValueType::INT64; }
+        TelemetryUnit unit() const { return at ? (TelemetryUnit)(uint8_t)at[3] : TelemetryUnit::NONE; }
+
+        /* The stored 64 bits as the requested type (no conversion, check valueType() first)*/
+        uint64_t asUnsigned() const { return at ? loadBigEndian64(at + 4) : 0; }
+        int64_t asInteger() const { return (int64_t)asUnsigned(); }
+        bool asBool() const { return asUnsigned() != 0; }
+        double asReal() const
+        {
+            uint64_t bits = asUnsigned();
+            double value;
+            memcpy(&value, &bits, sizeof(value));
+            return value;
+        }
+
+        /* The value converted to double, whatever its type*/
+        double asNumber() const
+        {
+            switch (valueType())
+            {
+            case TelemetryValueType::FLOAT64:
+                return asReal();
+            case TelemetryValueType::UINT64:
+                return (double)asUnsigned();
+            default:
+                return (double)asInteger();
+            }
+        }
+    };
+
+private:
+    const char *data;
+    size_t length;
+
+public:
+    TelemetryView(const char *a_data, size_t a_length) : data(nullptr), length(0)
+    {
+        if (a_length >= TelemetryMessage::HEADER_SIZE && (uint8_t)a_data[0] == TelemetryMessage::VERSION &&
+            (uint8_t)a_data[1] >= (uint8_t)TelemetryType::READINGS && (uint8_t)a_data[1] <= (uint8_t)TelemetryType::ACK &&
+            a_length >= TelemetryMessage::encodedSize(loadBigEndian16(a_data + 2)))
+        {
+            data = a_data;
+            length = TelemetryMessage::encodedSize(loadBigEndian16(a_data + 2));
+        }
+    }
+
+    bool valid() const { return data != nullptr; }
+    size_t size() const { return length; } /* Bytes of the message (trailing bytes of the buffer excluded)*/
+
+    TelemetryType type() const { return data ? (TelemetryType)(uint8_t)data[1] : TelemetryType::READINGS; }
+    uint16_t readingCount() const { return data ? loadBigEndian16(data + 2) : 0; }
+    uint32_t deviceId() const { return data ? loadBigEndian32(data + 4) : 0; }
+    uint32_t sequence() const { return data ? loadBigEndian32(data + 8) : 0; }
+    uint64_t timestampUs() const { return data ? loadBigEndian64(data + 12) : 0; }
+
+    Reading reading(size_t a_index) const
+    {
+        if (a_index >= readingCount())
+        {
+            return Reading();
+        }
+        const char *at = data + TelemetryMessage::HEADER_SIZE + a_index * TelemetryMessage::READING_SIZE;
+        uint8_t valueType = (uint8_t)at[2];
+        if (valueType < (uint8_t)TelemetryValueType::INT64 || valueType > (uint8_t)TelemetryValueType::BOOL)
+        {
+            return Reading();
+        }
+        return Reading(at);
+    }
+};
+
+#endif // TELEMETRYVIEW_HPP
@@ -0,0 +1,100 @@
+#ifndef TIMERWHEEL_HPP
+#define TIMERWHEEL_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+/*
+ ? TimerWheel:
+ * Hierarchical timing wheel (Varghese & Lauck) counting in ticks. LEVEL_COUNT wheels of
+ * SLOT_COUNT slots each: level 0 has one slot per tick, level 1 one slot per 256 ticks, and so on,
+ * so 4 levels cover 2^32 ticks (~49 days at 1 ms). Longer delays wait in the last level and are
+ * placed again when it comes around.
+ *
+ *   schedule / cancel / reschedule : O(1), the timer is linked into (or out of) one slot list.
+ *   advance                        : O(1) per tick plus the timers that fire; every 256 ticks one
+ *                                    slot of the next level is cascaded down (re-placed closer).
+ *
+ * Timers live in a slab (vector + free list) and the slot lists are intrusive, so scheduling
+ * doesn't allocate once the slab has grown (beyond what std::function needs for the callback).
+ * A TimerId carries a generation, so cancelling a timer that already fired is a harmless no-op.
+ *
+ * Single-threaded: EventLoop owns one and drives it from its thread (see EventLoop::addTimer).
+ */
+class TimerWheel
+{
+public:
+    using TimerId = uint64_t; /* 0 is never a valid id*/
+    using TimerCallback = std::function<void()>;
+
+    static constexpr size_t LEVEL_COUNT = 4;
+    static constexpr unsigned SLOT_BITS = 8;
+    static constexpr size_t SLOT_COUNT = size_t(1) << SLOT_BITS;
+
+private:
+    static constexpr int32_t NONE = -1;
+
+    struct Timer
+    {
+        TimerCallback callback;
+        uint64_t expiry = 0;      /* Tick at which it fires*/
+        uint64_t period = 0;      /* Ticks between runs, 0 for a one-shot timer*/
+        uint32_t generation = 1;  /* Bumped when the node is freed, stale ids no longer match*/
+        int32_t previous = NONE;
+        int32_t next = NONE;
+        int32_t *list = nullptr;  /* Head of the list it is linked into (nullptr: free or running)*/
+        int32_t level = NONE;     /* Wheel level and slot of that list (NONE for the firing list)*/
+        int32_t slot = NONE;
+    };
+
+    std::vector<Timer> timers;
+    int32_t freeHead;
+    size_t activeCount;
+
+    /** @param  slots : Head of every slot list, per level. */
+    int32_t slots[LEVEL_COUNT][SLOT_COUNT];
+
+    /** @param  occupied : One bit per non-empty level 0 slot, to find the next expiry without scanning. */
+    uint64_t occupied[SLOT_COUNT / 64];
+
+    /** @param  levelCounts : Timers linked into each level (a cascade is only waited for when a higher level has some). */
+    size_t levelCounts[LEVEL_COUNT];
+
+    /** @param  firing : Timers detached from the slot being expired (a callback may cancel any of them). */
+    int32_t firing;
+
+    /** @param  currentTick : Every tick up to this one has been expired. */
+    uint64_t currentTick;
+
+    int32_t allocate();
+    void release(int32_t a_index);
+    void link(int32_t a_index, int32_t *a_list, int32_t a_level, int32_t a_slot);
+    void unlink(int32_t a_index);
+    void place(int32_t a_index);
+    void cascade(size_t a_level);
+    size_t expireCurrent();
+    int32_t find(TimerId a_id) const;
+
+public:
+    explicit TimerWheel(uint64_t a_startTick = 0);
+    TimerWheel(const TimerWheel &) = delete;
+    TimerWheel &operator=(const TimerWheel &) = delete;
+
+    /* Fires at a_expiryTick (the next tick if that has passed), then every a_period ticks if a_period > 0*/
+    TimerId schedule(uint64_t a_expiryTick, uint64_t a_period, TimerCallback a_callback);
+    bool reschedule(TimerId a_id, uint64_t a_expiryTick);
+    bool cancel(TimerId a_id);
+
+    /* Runs the callbacks of every timer due up to a_tick, returns how many ran*/
+    size_t advance(uint64_t a_tick);
+
+    /* Ticks from now until advance() has something to do (a timer or a cascade), -1 when empty*/
+    int64_t ticksUntilNext() const;
+
+    uint64_t now() const { return currentTick; }
+    size_t size() const { return activeCount; }
+};
+
+#endif // TIMERWHEEL_HPP
@@ -0,0 +1,84 @@
+#ifndef TOPICBROKER_HPP
+#define TOPICBROKER_HPP
+
+#include "Channel.hpp"
+#include "ReactorServerChannel.hpp"
+#include "TopicTrie.hpp"
+#include <string_view>
+
+/*
+ ? TopicBroker:
+ * Publish/subscribe over a ReactorServerChannel (LENGTH_PREFIXED framing). Clients subscribe to
+ * topic filters (see TopicTrie for the "+" and "#" wildcards) and publish to concrete topics;
+ * every PUBLISH is forwarded as a MESSAGE to the connections whose filters match, each once.
+ *
+ * Frame payload:
+ *   0  uint8   operation      Operation
+ *   1  uint16  topicLength    big-endian
+ *   3  topic                  topicLength bytes (a filter for SUBSCRIBE/UNSUBSCRIBE)
+ *   .. payload                the rest of the frame (PUBLISH/MESSAGE only, any bytes)
+ *
+ * Received frames are parsed in place (receiveView) and forwarded without copying: the MESSAGE
+ * is the PUBLISH frame with its first byte swapped for a separate one (scatter-gather send).
+ * The server application can publish too (publish()), e.g. readings it collected itself.
+ *
+ * The broker owns the channel's readable and disconnect callbacks; onConnect() is free to use.
+ * Clients use the static subscribe()/unsubscribe()/publish() helpers on a ClientChannel with
+ * LENGTH_PREFIXED framing, and parse() on every frame they receive.
+ */
+class TopicBroker
+{
+public:
+    enum class Operation : uint8_t
+    {
+        SUBSCRIBE = 1,
+        UNSUBSCRIBE = 2,
+        PUBLISH = 3,
+        MESSAGE = 4
+    };
+
+    static constexpr size_t HEADER_SIZE = 3;
+
+private:
+    /** @param  channel : Serves the client connections, owned by the broker. */
+    ReactorServerChannel channel;
+
+    TopicTrie subscriptions;
+
+    /** @param  filters : Filters of every connection, removed from the trie when it disconnects. */
+    std::unordered_map<int, std::vector<std::string>> filters;
+
+    /** @param  matches : Reused by every publish, routing doesn't allocate once it has grown. */
+    std::vector<int> matches;
+
+    void handleFrame(int a_connectionId, const char *a_frame, size_t a_length);
+    void removeConnection(int a_connectionId);
+    size_t deliver(std::string_view a_topic, const MessageSegment *a_segments, size_t a_count);
+    static SocketResult sendFrame(Channel &a_channel, Operation a_operation, std::string_view a_topic, const char *a_payload, size_t a_payloadLength);
+
+public:
+    explicit TopicBroker(Socket *a_listenSocket, EventLoop &a_loop, int a_port, const std::string a_ip = "");
+    TopicBroker(const TopicBroker &) = delete;
+    TopicBroker &operator=(const TopicBroker &) = delete;
+
+    SocketResult start();
+    void stop();
+
+    /* Publishes from the server side, returns the number of connections it was sent to*/
+    size_t publish(std::string_view a_topic, const char *a_payload, size_t a_length);
+    size_t subscriptionCount() const { return subscriptions.size(); }
+    ReactorServerChannel &getChannel() { return channel; }
+
+    /* Client side*/
+    static SocketResult subscribe(Channel &a_channel, std::string_view a_filter);
+    static SocketResult unsubscribe(Channel &a_channel, std::string_view a_filter);
+    static SocketResult publish(Channel &a_channel, std::string_view a_topic, const char *a_payload, size_t a_length);
+
+    /* Splits a received frame, the views point into a_frame. false: truncated or unknown operation*/
+    static bool parse(const char *a_frame, size_t a_length, Operation &a_operation, std::string_view &a_topic, std::string_view &a_payload);
+
+    // Destructor for TopicBroker
+    ~TopicBroker();
+};
+
+#endif // TOPICBROKER_HPP
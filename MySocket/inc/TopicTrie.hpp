@@ -0,0 +1,69 @@
+#ifndef TOPICTRIE_HPP
+#define TOPICTRIE_HPP
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+/*
+ ? TopicTrie:
+ * Subscriptions compiled into a trie over topic levels ("site1/building2/temperature" has three
+ * levels), with MQTT-style wildcards in the filters:
+ *   +  one whole level           "site1/+/temperature" matches "site1/b2/temperature"
+ *   #  the rest, last level only  "site1/#" matches "site1", "site1/b2", "site1/b2/temperature"
+ *
+ * Matching a topic walks one trie path per wildcard branch, so its cost depends on the topic
+ * depth and the number of distinct filters along it, not on how many subscribers there are.
+ * Levels are looked up as string_views into the topic (heterogeneous lookup), nothing is allocated.
+ *
+ * Subscribers are plain integer ids (the broker uses connection ids).
+ */
+class TopicTrie
+{
+private:
+    struct LevelHash
+    {
+        using is_transparent = void;
+        size_t operator()(std::string_view a_level) const { return std::hash<std::string_view>()(a_level); }
+    };
+
+    struct Node
+    {
+        std::unordered_map<std::string, std::unique_ptr<Node>, LevelHash, std::equal_to<>> children;
+        std::unique_ptr<Node> singleLevel; /* "+" */
+        std::unique_ptr<Node> multiLevel;  /* "#" */
+        std::vector<int> subscribers;
+
+        bool empty() const { return children.empty() && !singleLevel && !multiLevel && subscribers.empty(); }
+    };
+
+    Node root;
+    size_t subscriptionCount;
+
+    static bool nextLevel(std::string_view &a_rest, std::string_view &a_level);
+    static void collect(const Node &a_node, std::vector<int> &a_matches);
+    void matchFrom(const Node &a_node, std::string_view a_rest, bool a_atEnd, std::vector<int> &a_matches) const;
+    bool removeFrom(Node &a_node, std::string_view a_rest, bool a_atEnd, int a_subscriber);
+
+public:
+    TopicTrie();
+    TopicTrie(const TopicTrie &) = delete;
+    TopicTrie &operator=(const TopicTrie &) = delete;
+
+    static bool isValidFilter(std::string_view a_filter);
+    static bool isValidTopic(std::string_view a_topic); /* No wildcards, published topics are concrete*/
+
+    bool subscribe(std::string_view a_filter, int a_subscriber);   /* false: invalid filter or already subscribed*/
+    bool unsubscribe(std::string_view a_filter, int a_subscriber); /* false: wasn't subscribed*/
+
+    /* Subscribers of a_topic, each once (a_matches is cleared first, reuse it to avoid allocations)*/
+    void match(std::string_view a_topic, std::vector<int> &a_matches) const;
+
+    size_t size() const { return subscriptionCount; }
+};
+
+#endif // TOPICTRIE_HPP
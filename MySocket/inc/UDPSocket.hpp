@@ -2,6 +2,20 @@
 #define UDPSOCKET_HPP
 
 #include "Socket.hpp"
+#include "IOUring.hpp"
+#include "DatagramBatch.hpp"
+#include "MulticastGroups.hpp"
+#include "BufferPool.hpp"
+#include <netinet/udp.h> // For UDP_SEGMENT and UDP_GRO
+#include <algorithm>
+#include <memory>
+
+#ifndef UDP_SEGMENT
+#define UDP_SEGMENT 103 /* Older libc headers, the kernel has had it since 4.18*/
+#endif
+#ifndef UDP_GRO
+#define UDP_GRO 104
+#endif
 
 /*
   ? enum class Advantages:
@@ -42,18 +56,105 @@ private:
     /** @param  ttl : TTL (Time to Live) for the multicast packet. */
     unsigned char ttl;
 
+    /** @param  backend : Blocking system calls or batched io_uring submissions. */
+    IOBackendType backend;
+
+    /** @param  timeouts : Send/receive deadlines (connect only records the destination). */
+    SocketTimeouts timeouts;
+
+    /** @param  tuning : Socket options of the profile (buffer sizes matter most for bursty receivers). */
+    SocketTuning tuning;
+
+    /** @param  busyPollBudgetUs : Spin budget of blocking receives, 0: off (see TCPSocket::setBusyPoll). */
+    int busyPollBudgetUs = 0;
+
+    bool nonBlocking = false; /* O_NONBLOCK set, receives never spin*/
+
+    /** @param  gsoState : UDP_SEGMENT support, probed by the first sendSegmented() (sendmmsg when unsupported). */
+    enum class GsoState
+    {
+        UNKNOWN,
+        SUPPORTED,
+        UNSUPPORTED
+    } gsoState = GsoState::UNKNOWN;
+
+    /** @param  gsoRejectedSize : Smallest segment size refused as above the path MTU (EINVAL/EMSGSIZE), 0: none; larger ones use sendmmsg. */
+    size_t gsoRejectedSize = 0;
+
+    /** @param  viewBuffer : receiveView() target, taken from the pool on first use. */
+    BufferPool::Buffer viewBuffer;
+
+    static constexpr size_t MAX_GSO_SEGMENTS = 64;     /* UDP_MAX_SEGMENTS of the kernel*/
+    static constexpr size_t MAX_DATAGRAM_SIZE = 65507; /* 65535 - IPv4 header - UDP header*/
+
+    /** @param  ring : Thread ring used by the IO_URING backend. */
+    IOUring *ring = nullptr;
+
+    /*
+     * io_uring datagram send: a slot holds a copy of the payload and destination until the
+     * kernel completes it, then goes back to the socket's free list. The slots and their pool
+     * buffers are reused, so a queued datagram costs one copy and no allocation.
+     */
+    struct UringDatagramRequest : IOUring::Request
+    {
+        UDPSocket *owner = nullptr;
+        BufferPool::Buffer payload;
+        struct sockaddr_in destination;
+        struct iovec segment;
+        struct msghdr header;
+        void complete(int a_result) override;
+    };
+
+    static constexpr size_t URING_SEND_SLOTS = 64; /* Datagrams in flight per socket, the next send waits for one*/
+
+    /** @param  sendSlots : io_uring send slots, allocated on the first send. */
+    std::unique_ptr<UringDatagramRequest[]> sendSlots;
+
+    /** @param  freeSlots : Slots not in flight (reserved for every slot, complete() never allocates). */
+    std::vector<UringDatagramRequest *> freeSlots;
+
+    UringDatagramRequest *acquireSendSlot();
+    void drainSends();
+
+    SocketResult recvFromBytes(char *a_buffer, size_t a_length, struct sockaddr_in *a_from, int a_flags = 0);
+    SocketResult sendBatch(struct mmsghdr *a_headers, size_t a_count);
+    SocketResult sendHeader(struct msghdr *a_message, size_t a_datagrams = 1);
+    SocketResult sendChunk(const char *a_data, size_t a_length, size_t a_segmentSize);
+    SocketResult sendChunkFallback(const char *a_data, size_t a_length, size_t a_segmentSize);
+    bool probeGso();
+
 public:
-    UDPSocket(CommunicationType a_CommunicationType = CommunicationType::UNICAST, unsigned char a_ttl = 1) ;
+    UDPSocket(CommunicationType a_CommunicationType = CommunicationType::UNICAST, unsigned char a_ttl = 1, IOBackendType a_backend = IOBackendType::BLOCKING) ;
     const struct sockaddr_in* getAddress() const override;
-    void SetTTL(unsigned char a_ttl);
-    void JoinMulticast(const std::string &multicast_ip, int multicast_port);
-    void connect(const std::string &a_ip, int a_port) override;
-    void bind(const std::string &a_ip, int a_port) override;
-    void listen(int backlog = 5) override;
-    Socket *accept() override;  void send(const std::string &message) override;
+    int getFD() const override;
+    SocketResult setNonBlocking(bool a_nonBlocking) override;
+    void setTimeouts(const SocketTimeouts &a_timeouts) override;
+    SocketTimeouts getTimeouts() const override;
+    SocketResult setTuning(const SocketTuning &a_tuning) override;
+    SocketTuning getTuning() const override;
+    SocketResult setBusyPoll(int a_spinBudgetUs) override;
+    SocketResult SetTTL(unsigned char a_ttl);
+    SocketResult JoinMulticast(const std::string &multicast_ip, int multicast_port);
+    SocketResult connect(const std::string &a_ip, int a_port) override;
+    SocketResult bind(const std::string &a_ip, int a_port) override;
+    SocketResult listen(int backlog = 5) override;
+    Socket *accept() override;
+    SocketResult send(const std::string &message) override;
+    SocketResult send(const MessageSegment *a_segments, size_t a_count) override;
     std::string receive() override;
+    SocketResult receive(std::string &a_message) override;
+    SocketResult receive(char *a_buffer, size_t a_length) override;
+    SocketResult receiveView(const char *&a_data, size_t &a_length) override;
+    SocketResult receiveBatch(DatagramBatch &a_batch, bool a_waitForFirst = true, size_t a_maxCount = 0);
+    SocketResult publish(MulticastGroups &a_groups, const std::string &message);
+    SocketResult publish(MulticastGroups &a_groups, const MessageSegment *a_segments, size_t a_count); /* One datagram to every group*/
+    SocketResult publishEach(MulticastGroups &a_groups, const MessageSegment *a_payloads); /* a_payloads[i] to group i*/
+    SocketResult sendSegmented(const void *a_data, size_t a_length, size_t a_segmentSize); /* a_length / a_segmentSize datagrams (GSO)*/
+    SocketResult enableGRO(bool a_enable = true); /* Coalesced receive, see DatagramBatch*/
+    void flush() override;
     void LeaveMulticast(void);
     void shutdown() override;
+    ~UDPSocket() override;
     
 };
 
@@ -0,0 +1,68 @@
+#ifndef ZEROCOPYTRACKER_HPP
+#define ZEROCOPYTRACKER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <list>
+
+/*
+ ? ZeroCopyTracker:
+ * Bookkeeping for MSG_ZEROCOPY sends on one socket.
+ *
+ * With MSG_ZEROCOPY the kernel transmits straight from the caller's pages, so the buffer must stay
+ * untouched until the kernel reports it is done. Every successful sendmsg(MSG_ZEROCOPY) call on a
+ * socket gets the next 32-bit id (0, 1, 2...), and completions arrive on the socket error queue
+ * as inclusive id ranges [ee_info, ee_data]. A buffer may need several sendmsg calls (short sends,
+ * or a send resumed after WOULD_BLOCK), so it is open while it is being sent and released once it
+ * is closed and all of its ids have been reported.
+ *
+ * Bytes sent ahead of a buffer (a frame header) are pinned like the buffer itself, so they are
+ * kept in its entry: prefix() stays valid until the buffer is released.
+ */
+class ZeroCopyTracker
+{
+public:
+    using ReleaseCallback = std::function<void()>;
+
+    static constexpr size_t PREFIX_CAPACITY = 8;
+
+private:
+    struct PendingBuffer
+    {
+        uint32_t firstId;
+        uint32_t lastId;
+        uint32_t sentCalls;
+        uint32_t outstandingCalls;
+        bool open; /* Still being sent, not released even when every call so far completed*/
+        ReleaseCallback release;
+        char prefix[PREFIX_CAPACITY];
+    };
+
+    /** @param  pending : Buffers still referenced by the kernel, in send order. */
+    std::list<PendingBuffer> pending;
+
+    /** @param  nextId : Id the kernel will assign to the next successful MSG_ZEROCOPY call. */
+    uint32_t nextId;
+
+    /** @param  copiedCompletions : Completions where the kernel fell back to copying (e.g. loopback). */
+    size_t copiedCompletions;
+
+    void complete(uint32_t a_firstId, uint32_t a_lastId);
+
+public:
+    ZeroCopyTracker();
+
+    char *open(ReleaseCallback a_release);
+    char *openPrefix();
+    uint32_t sendCompleted();
+    void close();
+    size_t readCompletions(int a_fd);
+    void releaseAll();
+
+    size_t pendingBuffers() const;
+    bool hasOutstandingCalls() const;
+    size_t copiedCount() const;
+};
+
+#endif // ZEROCOPYTRACKER_HPP
@@ -5,15 +5,51 @@ MYSOCKET_INC_DIR = $(MY_SOCKET_DIR)/inc
 MYSOCKET_SRC_DIR = $(MY_SOCKET_DIR)/src
 MYSOCKET_OBJ_DIR = $(ROOT_DIR)/Application/out/gen
 MYSOCKET_LIB_DIR = $(ROOT_DIR)/Application/out/lib
+MYSOCKET_BENCH_DIR = $(MY_SOCKET_DIR)/bench
+MYSOCKET_BIN_DIR = $(ROOT_DIR)/Application/out/bin
 
-MYSOCKET_SRC = $(MYSOCKET_SRC_DIR)/TCPSocket.cpp $(MYSOCKET_SRC_DIR)/UDPSocket.cpp $(MYSOCKET_SRC_DIR)/ServerChannel.cpp $(MYSOCKET_SRC_DIR)/ClientChannel.cpp
-MYSOCKET_OBJ = $(MYSOCKET_OBJ_DIR)/TCPSocket.o $(MYSOCKET_OBJ_DIR)/UDPSocket.o $(MYSOCKET_OBJ_DIR)/ServerChannel.o $(MYSOCKET_OBJ_DIR)/ClientChannel.o
+MYSOCKET_SRC = $(MYSOCKET_SRC_DIR)/TCPSocket.cpp $(MYSOCKET_SRC_DIR)/UDPSocket.cpp $(MYSOCKET_SRC_DIR)/ServerChannel.cpp $(MYSOCKET_SRC_DIR)/ClientChannel.cpp \
+              $(MYSOCKET_SRC_DIR)/EventLoop.cpp $(MYSOCKET_SRC_DIR)/ReactorServerChannel.cpp \
+              $(MYSOCKET_SRC_DIR)/IOUring.cpp $(MYSOCKET_SRC_DIR)/DatagramBatch.cpp \
+              $(MYSOCKET_SRC_DIR)/FrameDecoder.cpp $(MYSOCKET_SRC_DIR)/ZeroCopyTracker.cpp \
+              $(MYSOCKET_SRC_DIR)/ShardedServerChannel.cpp $(MYSOCKET_SRC_DIR)/SocketResult.cpp \
+              $(MYSOCKET_SRC_DIR)/ConnectionPool.cpp $(MYSOCKET_SRC_DIR)/BufferPool.cpp \
+              $(MYSOCKET_SRC_DIR)/IOThread.cpp $(MYSOCKET_SRC_DIR)/AsyncChannel.cpp \
+              $(MYSOCKET_SRC_DIR)/MulticastGroups.cpp $(MYSOCKET_SRC_DIR)/SocketStats.cpp \
+              $(MYSOCKET_SRC_DIR)/LatencyHistogram.cpp $(MYSOCKET_SRC_DIR)/LatencyRecorder.cpp \
+              $(MYSOCKET_SRC_DIR)/TelemetryMessage.cpp $(MYSOCKET_SRC_DIR)/TimerWheel.cpp \
+              $(MYSOCKET_SRC_DIR)/TopicTrie.cpp $(MYSOCKET_SRC_DIR)/TopicBroker.cpp \
+              $(MYSOCKET_SRC_DIR)/SendQueue.cpp $(MYSOCKET_SRC_DIR)/SocketTuning.cpp
+MYSOCKET_OBJ = $(MYSOCKET_OBJ_DIR)/TCPSocket.o $(MYSOCKET_OBJ_DIR)/UDPSocket.o $(MYSOCKET_OBJ_DIR)/ServerChannel.o $(MYSOCKET_OBJ_DIR)/ClientChannel.o \
+              $(MYSOCKET_OBJ_DIR)/EventLoop.o $(MYSOCKET_OBJ_DIR)/ReactorServerChannel.o \
+              $(MYSOCKET_OBJ_DIR)/IOUring.o $(MYSOCKET_OBJ_DIR)/DatagramBatch.o \
+              $(MYSOCKET_OBJ_DIR)/FrameDecoder.o $(MYSOCKET_OBJ_DIR)/ZeroCopyTracker.o \
+              $(MYSOCKET_OBJ_DIR)/ShardedServerChannel.o $(MYSOCKET_OBJ_DIR)/SocketResult.o \
+              $(MYSOCKET_OBJ_DIR)/ConnectionPool.o $(MYSOCKET_OBJ_DIR)/BufferPool.o \
+              $(MYSOCKET_OBJ_DIR)/IOThread.o $(MYSOCKET_OBJ_DIR)/AsyncChannel.o \
+              $(MYSOCKET_OBJ_DIR)/MulticastGroups.o $(MYSOCKET_OBJ_DIR)/SocketStats.o \
+              $(MYSOCKET_OBJ_DIR)/LatencyHistogram.o $(MYSOCKET_OBJ_DIR)/LatencyRecorder.o \
+              $(MYSOCKET_OBJ_DIR)/TelemetryMessage.o $(MYSOCKET_OBJ_DIR)/TimerWheel.o \
+              $(MYSOCKET_OBJ_DIR)/TopicTrie.o $(MYSOCKET_OBJ_DIR)/TopicBroker.o \
+              $(MYSOCKET_OBJ_DIR)/SendQueue.o $(MYSOCKET_OBJ_DIR)/SocketTuning.o
 # Static Library File
 MYSOCKET_LIB = $(MYSOCKET_LIB_DIR)/libMySocket.a
 
+# Loopback benchmark suite (make -f my_socket.mk bench BENCH_ARGS="--quick")
+MYSOCKET_BENCH_SRC = $(MYSOCKET_BENCH_DIR)/Bench.cpp $(MYSOCKET_BENCH_DIR)/TCPBench.cpp $(MYSOCKET_BENCH_DIR)/UDPBench.cpp \
+                     $(MYSOCKET_BENCH_DIR)/TimerBench.cpp
+MYSOCKET_BENCH_BIN = $(MYSOCKET_BIN_DIR)/mysocket_bench
+BENCH_OUTPUT = $(ROOT_DIR)/Application/out/bench.json
+BENCH_ARGS =
+
+# Steady-state receive allocation check (make -f my_socket.mk check)
+MYSOCKET_CHECK_SRC = $(MYSOCKET_BENCH_DIR)/AllocationCheck.cpp
+MYSOCKET_CHECK_BIN = $(MYSOCKET_BIN_DIR)/mysocket_alloc_check
+CHECK_ARGS =
+
 # Compiler and flags
 CC = g++
-CFLAGS = -Wall -std=c++17
+CFLAGS = -Wall -std=c++20 -O2
 
 all: $(MYSOCKET_LIB)
 
@@ -35,7 +71,23 @@ $(MYSOCKET_LIB): $(MYSOCKET_OBJ)
 #c creates the archive if it doesn’t exist.
 #s writes an index into the archive.
 
+$(MYSOCKET_BENCH_BIN): $(MYSOCKET_BENCH_SRC) $(MYSOCKET_BENCH_DIR)/Bench.hpp $(MYSOCKET_LIB)
+	mkdir -p $(MYSOCKET_BIN_DIR)
+	$(CC) $(CFLAGS) -I$(MYSOCKET_INC_DIR) $(MYSOCKET_BENCH_SRC) $(MYSOCKET_LIB) -pthread -o $@
+
+# Builds the suite and runs it, results go to stdout and (as JSON) to BENCH_OUTPUT
+bench: $(MYSOCKET_BENCH_BIN)
+	$(MYSOCKET_BENCH_BIN) --output $(BENCH_OUTPUT) $(BENCH_ARGS)
+
+$(MYSOCKET_CHECK_BIN): $(MYSOCKET_CHECK_SRC) $(MYSOCKET_LIB)
+	mkdir -p $(MYSOCKET_BIN_DIR)
+	$(CC) $(CFLAGS) -I$(MYSOCKET_INC_DIR) $(MYSOCKET_CHECK_SRC) $(MYSOCKET_LIB) -pthread -o $@
+
+# Fails (non-zero exit) when a receive into caller-owned memory allocates
+check: $(MYSOCKET_CHECK_BIN)
+	$(MYSOCKET_CHECK_BIN) $(CHECK_ARGS)
+
 clean:
-	rm -rf $(MYSOCKET_OBJ) $(MYSOCKET_LIB)
+	rm -rf $(MYSOCKET_OBJ) $(MYSOCKET_LIB) $(MYSOCKET_BENCH_BIN) $(MYSOCKET_CHECK_BIN)
 
-.PHONY: all clean
\ No newline at end of file
+.PHONY: all bench check clean
\ No newline at end of file
@@ -0,0 +1,275 @@
+#include "AsyncChannel.hpp"
+
+AsyncChannel::AsyncChannel(Channel &a_channel, EventLoop &a_loop)
+    : channel(a_channel), loop(a_loop), watchedFD(-1), reader(nullptr), writer(nullptr)
+{
+    prepare(channel.getSocket());
+}
+
+void AsyncChannel::prepare(Socket *a_socket)
+{
+    /*
+     * Deadlines would make the socket poll() inside the operation and stall every other session
+     * of the loop, so waiting is left to the loop alone: non-blocking, no deadlines.
+     */
+    if (a_socket != nullptr)
+    {
+        a_socket->setNonBlocking(true);
+        a_socket->setTimeouts(SocketTimeouts());
+    }
+}
+
+bool AsyncChannel::Operation::await_suspend(std::coroutine_handle<> a_handle)
+{
+    /* false resumes the coroutine right away (result already holds the reason)*/
+    waiting = a_handle;
+    return owner.wait(*this);
+}
+
+bool AsyncChannel::wait(Operation &a_operation)
+{
+    Operation *&slot = (a_operation.events & EPOLLIN) ? reader : writer;
+    if (slot != nullptr)
+    {
+        a_operation.result = SocketResult::fromErrno(EBUSY);
+        return false;
+    }
+    Socket *socket = channel.getSocket();
+    if (socket == nullptr)
+    {
+        a_operation.result = SocketResult::fromErrno(EBADF);
+        return false;
+    }
+
+    /* A ServerChannel moves from the listening socket to the accepted one*/
+    int fd = socket->getFD();
+    if (watchedFD >= 0 && watchedFD != fd)
+    {
+        loop.remove(watchedFD);
+        watchedFD = -1;
+    }
+    slot = &a_operation;
+    if (!updateRegistration(fd))
+    {
+        slot = nullptr;
+        a_operation.result = SocketResult::fromErrno(errno != 0 ? errno : EINVAL);
+        return false;
+    }
+    return true;
+}
+
+bool AsyncChannel::updateRegistration(int a_fd)
+{
+    /* The descriptor is only watched while an operation waits (no wakeups for idle sessions)*/
+    uint32_t events = (reader != nullptr ? EPOLLIN : 0) | (writer != nullptr ? EPOLLOUT : 0);
+    if (events == 0)
+    {
+        if (watchedFD >= 0)
+        {
+            loop.remove(watchedFD);
+            watchedFD = -1;
+        }
+        return true;
+    }
+    if (watchedFD >= 0)
+    {
+        return loop.modify(watchedFD, events);
+    }
+    if (!loop.add(a_fd, events, [this](uint32_t a_events)
+                  { onEvents(a_events); }))
+    {
+        return false;
+    }
+    watchedFD = a_fd;
+    return true;
+}
+
+void AsyncChannel::onEvents(uint32_t a_events)
+{
+    /*
+     ! Resuming:
+     * The operations are retried first and the registration updated before any coroutine runs,
+     * since a resumed coroutine may start its next operation, or end and destroy this channel.
+     */
+    std::coroutine_handle<> ready[2];
+    size_t readyCount = 0;
+    if (reader != nullptr && (a_events & (EPOLLIN | EPOLLHUP | EPOLLERR)) && reader->attempt())
+    {
+        ready[readyCount++] = reader->waiting;
+        reader = nullptr;
+    }
+    if (writer != nullptr && (a_events & (EPOLLOUT | EPOLLHUP | EPOLLERR)) && writer->attempt())
+    {
+        ready[readyCount++] = writer->waiting;
+        writer = nullptr;
+    }
+    if (readyCount == 0)
+    {
+        return;
+    }
+    updateRegistration(watchedFD);
+    for (size_t i = 0; i < readyCount; i++)
+    {
+        ready[i].resume();
+    }
+}
+
+bool AsyncChannel::StartOperation::attempt()
+{
+    if (connecting)
+    {
+        /* The non-blocking connect finished, SO_ERROR holds the outcome (0 or e.g. ECONNREFUSED)*/
+        int error = 0;
+        socklen_t length = sizeof(error);
+        if (getsockopt(owner.channel.getSocket()->getFD(), SOL_SOCKET, SO_ERROR, &error, &length) < 0)
+        {
+            error = errno;
+        }
+        result = (error == 0) ? SocketResult::success() : SocketResult::fromErrno(error);
+        return true;
+    }
+
+    result = owner.channel.start();
+    if (result.status != SocketStatus::WOULD_BLOCK)
+    {
+        /* A pooled connection or an accepted socket is new to this channel*/
+        owner.prepare(owner.channel.getSocket());
+        return true;
+    }
+    /* Client: connect in progress (writable when done). Server: no client yet (readable when one is)*/
+    connecting = (result.errorNumber == EINPROGRESS);
+    events = connecting ? EPOLLOUT : EPOLLIN;
+    return false;
+}
+
+AsyncChannel::SendOperation::SendOperation(AsyncChannel &a_owner, const MessageSegment *a_segments, size_t a_count)
+    : Operation(a_owner, EPOLLOUT), single({nullptr, 0}), segments(a_segments), count(a_count)
+{
+}
+
+AsyncChannel::SendOperation::SendOperation(AsyncChannel &a_owner, const std::string &a_message)
+    : Operation(a_owner, EPOLLOUT), single({a_message.data(), a_message.size()}), segments(&single), count(1)
+{
+}
+
+bool AsyncChannel::SendOperation::attempt()
+{
+    if (sent > 0 && owner.channel.getSocket() == nullptr)
+    {
+        result = SocketResult::fromErrno(EBADF);
+        result.bytes = sent;
+        return true;
+    }
+    /* The first try goes through the channel, a partial send is resumed on the socket*/
+    SocketResult attemptResult = (sent == 0) ? owner.channel.send(segments, count)
+                                             : owner.channel.getSocket()->sendRemaining(segments, count, sent);
+    sent += attemptResult.bytes;
+    if (attemptResult.status == SocketStatus::WOULD_BLOCK)
+    {
+        return false;
+    }
+    result = attemptResult;
+    result.bytes = sent;
+    return true;
+}
+
+bool AsyncChannel::ReceiveOperation::attempt()
+{
+    /* After stop() a pooled ClientChannel has no socket left*/
+    if (message != nullptr && owner.channel.getSocket() == nullptr)
+    {
+        result = SocketResult::fromErrno(EBADF);
+        return true;
+    }
+    result = (message != nullptr) ? owner.channel.getSocket()->receive(*message)
+                                  : owner.channel.receive(buffer, length);
+    return result.status != SocketStatus::WOULD_BLOCK;
+}
+
+bool AsyncChannel::MessageOperation::attempt()
+{
+    if (owner.channel.getSocket() == nullptr)
+    {
+        result = SocketResult::fromErrno(EBADF);
+        return true;
+    }
+    result = owner.channel.getSocket()->receive(received);
+    return result.status != SocketStatus::WOULD_BLOCK;
+}
+
+AsyncChannel::StartOperation AsyncChannel::start()
+{
+    return StartOperation(*this);
+}
+
+AsyncChannel::SendOperation AsyncChannel::send(const std::string &message)
+{
+    return SendOperation(*this, message);
+}
+
+AsyncChannel::SendOperation AsyncChannel::send(const MessageSegment *a_segments, size_t a_count)
+{
+    return SendOperation(*this, a_segments, a_count);
+}
+
+AsyncChannel::ReceiveOperation AsyncChannel::receive(std::string &a_message)
+{
+    return ReceiveOperation(*this, a_message);
+}
+
+AsyncChannel::ReceiveOperation AsyncChannel::receive(char *a_buffer, size_t a_length)
+{
+    return ReceiveOperation(*this, a_buffer, a_length);
+}
+
+AsyncChannel::MessageOperation AsyncChannel::receive()
+{
+    return MessageOperation(*this);
+}
+
+void AsyncChannel::stop()
+{
+    /*
+     ! Cancelling:
+     * Suspended operations end with ECANCELED instead of never resuming (their coroutine frames
+     * would leak). As in onEvents() the channel is stopped before any coroutine runs: a resumed
+     * coroutine may destroy this channel, so nothing touches it afterwards.
+     */
+    std::coroutine_handle<> cancelled[2];
+    size_t cancelledCount = 0;
+    for (Operation **slot : {&reader, &writer})
+    {
+        if (*slot != nullptr)
+        {
+            (*slot)->result = SocketResult::fromErrno(ECANCELED);
+            cancelled[cancelledCount++] = (*slot)->waiting;
+            *slot = nullptr;
+        }
+    }
+
+    /* The descriptor leaves epoll before the channel closes it*/
+    if (watchedFD >= 0)
+    {
+        loop.remove(watchedFD);
+        watchedFD = -1;
+    }
+    channel.stop();
+    for (size_t i = 0; i < cancelledCount; i++)
+    {
+        cancelled[i].resume();
+    }
+}
+
+Channel &AsyncChannel::getChannel() const
+{
+    return channel;
+}
+
+// Destructor for AsyncChannel
+AsyncChannel::~AsyncChannel()
+{
+    if (watchedFD >= 0)
+    {
+        loop.remove(watchedFD);
+    }
+}
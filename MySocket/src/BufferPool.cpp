@@ -0,0 +1,339 @@
+#include "BufferPool.hpp"
+#include <sys/mman.h> // For mmap, madvise, MAP_HUGETLB and MAP_POPULATE
+#include <algorithm>
+#include <cstring>
+
+BufferPool::BufferPool() : retiredHits(0), retiredMisses(0), slabs(0), reservedBytes(0), hugePagesUsed(false) {}
+
+BufferPool &BufferPool::instance()
+{
+    /*
+     * Never destroyed: thread caches hand their buffers back when their thread exits,
+     * which may happen after static destructors have started running.
+     */
+    static BufferPool *pool = new BufferPool();
+    return *pool;
+}
+
+BufferPool::ThreadCache &BufferPool::threadCache()
+{
+    thread_local ThreadCache cache;
+    return cache;
+}
+
+BufferPool::ThreadCache::ThreadCache()
+{
+    BufferPool &pool = instance();
+    std::lock_guard<std::mutex> guard(pool.cachesLock);
+    pool.caches.push_back(this);
+}
+
+BufferPool::ThreadCache::~ThreadCache()
+{
+    {
+        BufferPool &pool = instance();
+        std::lock_guard<std::mutex> guard(pool.cachesLock);
+        pool.caches.erase(std::find(pool.caches.begin(), pool.caches.end(), this));
+        pool.retiredHits += hits.load(std::memory_order_relaxed);
+        pool.retiredMisses += misses.load(std::memory_order_relaxed);
+    }
+
+    /* The buffers cached by an exiting thread go back to the global lists*/
+    for (size_t i = 0; i < CLASS_COUNT; i++)
+    {
+        if (head[i] != nullptr)
+        {
+            FreeBuffer *last = head[i];
+            while (last->next != nullptr)
+            {
+                last = last->next;
+            }
+            instance().pushGlobal(i, head[i], last, count[i]);
+            head[i] = nullptr;
+            count[i] = 0;
+        }
+    }
+}
+
+size_t BufferPool::classIndex(size_t a_size)
+{
+    size_t index = 0;
+    while (classSize(index) < a_size)
+    {
+        index++;
+    }
+    return index;
+}
+
+size_t BufferPool::classSize(size_t a_index)
+{
+    return MIN_BUFFER_SIZE << a_index;
+}
+
+void BufferPool::count(std::atomic<uint64_t> &a_counter)
+{
+    /* Only the owning thread writes its counters, stats() reads them*/
+    a_counter.store(a_counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+}
+
+bool BufferPool::configure(const Config &a_config)
+{
+    /* The slab layout can't change once buffers of the old layout are in circulation*/
+    if (slabs.load(std::memory_order_acquire) > 0)
+    {
+        return false;
+    }
+    config = a_config;
+    config.slabSize = std::max(config.slabSize, MAX_BUFFER_SIZE);
+    if (config.hugePages)
+    {
+        /* MAP_HUGETLB mappings must be a whole number of (2 MiB) huge pages*/
+        const size_t hugePageSize = 2 * 1024 * 1024;
+        config.slabSize = (config.slabSize + hugePageSize - 1) / hugePageSize * hugePageSize;
+    }
+    config.threadCacheLimit = std::max<size_t>(config.threadCacheLimit, 2);
+    return true;
+}
+
+bool BufferPool::addSlab(size_t a_index)
+{
+    /*
+     ! mmap instead of malloc:
+     * A slab is page aligned and independent of the heap. MAP_HUGETLB backs it with 2 MiB pages
+     * (one TLB entry for the whole slab) when huge pages are reserved (vm.nr_hugepages), otherwise
+     * madvise(MADV_HUGEPAGE) asks for transparent huge pages. MAP_POPULATE faults every page in now
+     * instead of on the first receive into it.
+     */
+    size_t slabSize = config.slabSize;
+    int flags = MAP_PRIVATE | MAP_ANONYMOUS | (config.prefault ? MAP_POPULATE : 0);
+    void *memory = MAP_FAILED;
+    bool huge = false;
+    if (config.hugePages)
+    {
+        memory = mmap(nullptr, slabSize, PROT_READ | PROT_WRITE, flags | MAP_HUGETLB, -1, 0);
+        huge = (memory != MAP_FAILED);
+    }
+    if (memory == MAP_FAILED)
+    {
+        memory = mmap(nullptr, slabSize, PROT_READ | PROT_WRITE, flags, -1, 0);
+        if (memory == MAP_FAILED)
+        {
+            return false;
+        }
+        if (config.hugePages)
+        {
+            madvise(memory, slabSize, MADV_HUGEPAGE);
+        }
+    }
+
+    /* The free list is stored in the buffers themselves*/
+    size_t bufferSize = classSize(a_index);
+    size_t bufferCount = slabSize / bufferSize;
+    char *base = (char *)memory;
+    for (size_t i = 0; i + 1 < bufferCount; i++)
+    {
+        ((FreeBuffer *)(base + i * bufferSize))->next = (FreeBuffer *)(base + (i + 1) * bufferSize);
+    }
+    FreeBuffer *last = (FreeBuffer *)(base + (bufferCount - 1) * bufferSize);
+    last->next = nullptr;
+    pushGlobal(a_index, (FreeBuffer *)base, last, bufferCount);
+
+    slabs.fetch_add(1, std::memory_order_relaxed);
+    reservedBytes.fetch_add(slabSize, std::memory_order_relaxed);
+    if (huge)
+    {
+        hugePagesUsed.store(true, std::memory_order_relaxed);
+    }
+    return true;
+}
+
+void BufferPool::pushGlobal(size_t a_index, FreeBuffer *a_first, FreeBuffer *a_last, size_t a_count)
+{
+    SizeClass &sizeClass = classes[a_index];
+    std::lock_guard<std::mutex> guard(sizeClass.lock);
+    a_last->next = sizeClass.head;
+    sizeClass.head = a_first;
+    sizeClass.count += a_count;
+}
+
+void BufferPool::reserve(size_t a_bufferSize, size_t a_count)
+{
+    /* Startup reservation: slabs are added until a_count buffers of that class are free*/
+    if (a_bufferSize > MAX_BUFFER_SIZE)
+    {
+        return;
+    }
+    size_t index = classIndex(a_bufferSize);
+    while (true)
+    {
+        {
+            std::lock_guard<std::mutex> guard(classes[index].lock);
+            if (classes[index].count >= a_count)
+            {
+                return;
+            }
+        }
+        if (!addSlab(index))
+        {
+            return;
+        }
+    }
+}
+
+char *BufferPool::acquire(size_t a_minimumSize, size_t &a_capacity)
+{
+    ThreadCache &cache = threadCache();
+    if (a_minimumSize > MAX_BUFFER_SIZE)
+    {
+        count(cache.misses);
+        a_capacity = a_minimumSize;
+        return new char[a_minimumSize];
+    }
+    size_t index = classIndex(a_minimumSize);
+    a_capacity = classSize(index);
+
+    /* Fast path: the thread cache, no lock*/
+    bool fromNewSlab = false;
+    while (cache.head[index] == nullptr)
+    {
+        /* Refill half a cache from the global list in one locked section*/
+        {
+            SizeClass &sizeClass = classes[index];
+            std::lock_guard<std::mutex> guard(sizeClass.lock);
+            size_t batch = config.threadCacheLimit / 2;
+            while (sizeClass.head != nullptr && batch-- > 0)
+            {
+                FreeBuffer *buffer = sizeClass.head;
+                sizeClass.head = buffer->next;
+                sizeClass.count--;
+                buffer->next = cache.head[index];
+                cache.head[index] = buffer;
+                cache.count[index]++;
+            }
+        }
+        if (cache.head[index] == nullptr)
+        {
+            if (!addSlab(index))
+            {
+                /* Out of address space: a heap buffer of the class size (it joins the pool when released)*/
+                count(cache.misses);
+                return new char[a_capacity];
+            }
+            fromNewSlab = true;
+        }
+    }
+
+    FreeBuffer *buffer = cache.head[index];
+    cache.head[index] = buffer->next;
+    cache.count[index]--;
+    count(fromNewSlab ? cache.misses : cache.hits);
+    return (char *)buffer;
+}
+
+void BufferPool::release(char *a_buffer, size_t a_capacity)
+{
+    if (a_buffer == nullptr)
+    {
+        return;
+    }
+    if (a_capacity > MAX_BUFFER_SIZE)
+    {
+        delete[] a_buffer;
+        return;
+    }
+    size_t index = classIndex(a_capacity);
+    ThreadCache &cache = threadCache();
+    FreeBuffer *buffer = (FreeBuffer *)a_buffer;
+    buffer->next = cache.head[index];
+    cache.head[index] = buffer;
+    cache.count[index]++;
+
+    /* A thread that only releases (e.g. a consumer of another thread's buffers) gives half back*/
+    if (cache.count[index] > config.threadCacheLimit)
+    {
+        size_t keep = config.threadCacheLimit / 2;
+        FreeBuffer *last = cache.head[index];
+        for (size_t i = 1; i < keep; i++)
+        {
+            last = last->next;
+        }
+        FreeBuffer *first = last->next;
+        size_t moved = cache.count[index] - keep;
+        FreeBuffer *tail = first;
+        while (tail->next != nullptr)
+        {
+            tail = tail->next;
+        }
+        last->next = nullptr;
+        cache.count[index] = keep;
+        pushGlobal(index, first, tail, moved);
+    }
+}
+
+BufferPool::Stats BufferPool::stats() const
+{
+    Stats result;
+    {
+        std::lock_guard<std::mutex> guard(cachesLock);
+        result.hits = retiredHits;
+        result.misses = retiredMisses;
+        for (const ThreadCache *cache : caches)
+        {
+            result.hits += cache->hits.load(std::memory_order_relaxed);
+            result.misses += cache->misses.load(std::memory_order_relaxed);
+        }
+    }
+    result.slabs = slabs.load(std::memory_order_relaxed);
+    result.reservedBytes = reservedBytes.load(std::memory_order_relaxed);
+    result.hugePages = hugePagesUsed.load(std::memory_order_relaxed);
+    return result;
+}
+
+BufferPool::Buffer::Buffer(size_t a_minimumSize) : memory(nullptr), size(0)
+{
+    memory = BufferPool::instance().acquire(a_minimumSize, size);
+}
+
+BufferPool::Buffer::Buffer(Buffer &&a_other) noexcept : memory(a_other.memory), size(a_other.size)
+{
+    a_other.memory = nullptr;
+    a_other.size = 0;
+}
+
+BufferPool::Buffer &BufferPool::Buffer::operator=(Buffer &&a_other) noexcept
+{
+    if (this != &a_other)
+    {
+        reset();
+        memory = a_other.memory;
+        size = a_other.size;
+        a_other.memory = nullptr;
+        a_other.size = 0;
+    }
+    return *this;
+}
+
+void BufferPool::Buffer::grow(size_t a_minimumSize, size_t a_keepBytes)
+{
+    size_t newSize;
+    char *newMemory = BufferPool::instance().acquire(a_minimumSize, newSize);
+    if (memory != nullptr && a_keepBytes > 0)
+    {
+        memcpy(newMemory, memory, std::min(a_keepBytes, size));
+    }
+    reset();
+    memory = newMemory;
+    size = newSize;
+}
+
+void BufferPool::Buffer::reset()
+{
+    BufferPool::instance().release(memory, size);
+    memory = nullptr;
+    size = 0;
+}
+
+BufferPool::Buffer::~Buffer()
+{
+    reset();
+}
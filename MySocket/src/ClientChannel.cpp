@@ -1,25 +1,236 @@
 #include "ClientChannel.hpp"
+#include <chrono>
 
- ClientChannel::ClientChannel(Socket *a_socket, int a_port, std::string a_ip) : Channel(a_socket), port(a_port), ip(a_ip) {}
+static uint64_t steadyNanoseconds()
+{
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
 
-void ClientChannel::start() 
+ ClientChannel::ClientChannel(Socket *a_socket, int a_port, std::string a_ip, TuningProfile a_profile) : Channel(a_socket), port(a_port), ip(a_ip), pool(nullptr), pooledConnection(nullptr), reusable(true), sentHead(0), sentCount(0)
 {
-    channelSocket->connect(ip, port);
-    channelStatus = ChannelStatusType::CHANNEL_ON;
+    /* Before the connect: the buffer sizes decide the window scale sent in the SYN*/
+    if (a_profile != TuningProfile::DEFAULT)
+    {
+        channelSocket->setTuning(SocketTuning::forProfile(a_profile));
+    }
 }
 
-void ClientChannel::send(const std::string &message) 
+ ClientChannel::ClientChannel(ConnectionPool &a_pool) : Channel(nullptr), port(0), pool(&a_pool), pooledConnection(nullptr), reusable(true), sentHead(0), sentCount(0) {}
+
+SocketResult ClientChannel::start() 
 {
-    channelSocket->send(message);
+    if (channelStatus == ChannelStatusType::CHANNEL_ON)
+    {
+        return SocketResult::success();
+    }
+    if (pool != nullptr)
+    {
+        /* A warm connection when the pool has one, otherwise a new connect (still no handshake with Fast Open)*/
+        SocketResult result = pool->acquire(pooledConnection);
+        if (result.ok())
+        {
+            channelSocket = pooledConnection;
+            borrowedBaseline = pooledConnection->stats();
+            reusable = true;
+            channelStatus = ChannelStatusType::CHANNEL_ON;
+        }
+        return result;
+    }
+
+    /*
+     * The channel is only ON once connected (a failed/timed out connect leaves it OFF), or while
+     * a non-blocking connect is in progress (WOULD_BLOCK, the socket turns writable when done).
+     */
+    SocketResult result = channelSocket->connect(ip, port);
+    if (result.ok() || result.errorNumber == EINPROGRESS)
+    {
+        channelStatus = ChannelStatusType::CHANNEL_ON;
+    }
+    return result;
+}
+
+SocketResult ClientChannel::track(SocketResult a_result)
+{
+    /* WOULD_BLOCK leaves the stream intact, anything else may have cut a message in half*/
+    if (!a_result.ok() && a_result.status != SocketStatus::WOULD_BLOCK)
+    {
+        reusable = false;
+    }
+    return a_result;
+}
+
+void ClientChannel::requestSent(uint64_t a_sentAt, const SocketResult &a_result)
+{
+    if (!a_result.ok())
+    {
+        return;
+    }
+    if (sentCount == MAX_UNANSWERED)
+    {
+        sentHead = (sentHead + 1) % MAX_UNANSWERED; /* Drop the oldest, it will not be answered*/
+        sentCount--;
+    }
+    sentAt[(sentHead + sentCount) % MAX_UNANSWERED] = a_sentAt;
+    sentCount++;
+}
+
+void ClientChannel::replyReceived(bool a_received)
+{
+    if (!a_received || sentCount == 0)
+    {
+        return;
+    }
+    uint64_t now = steadyNanoseconds();
+    latency->record(now - sentAt[sentHead]);
+    sentHead = (sentHead + 1) % MAX_UNANSWERED;
+    sentCount--;
+}
+
+SocketResult ClientChannel::send(const std::string &message) 
+{
+    if (channelSocket == nullptr)
+    {
+        return SocketResult::fromErrno(ENOTCONN);
+    }
+    if (latency)
+    {
+        uint64_t now = steadyNanoseconds();
+        SocketResult result = track(channelSocket->send(message));
+        requestSent(now, result);
+        return result;
+    }
+    return track(channelSocket->send(message));
+}
+
+SocketResult ClientChannel::send(const MessageSegment *a_segments, size_t a_count)
+{
+    if (channelSocket == nullptr)
+    {
+        return SocketResult::fromErrno(ENOTCONN);
+    }
+    if (latency)
+    {
+        uint64_t now = steadyNanoseconds();
+        SocketResult result = track(channelSocket->send(a_segments, a_count));
+        requestSent(now, result);
+        return result;
+    }
+    return track(channelSocket->send(a_segments, a_count));
 }
 
 std::string ClientChannel::receive() 
 {
-    return (channelSocket->receive());
+    std::string message;
+    if (channelSocket != nullptr)
+    {
+        SocketResult result = track(channelSocket->receive(message));
+        if (latency)
+        {
+            replyReceived(result.ok());
+        }
+    }
+    return message;
+}
+
+SocketResult ClientChannel::receive(char *a_buffer, size_t a_length)
+{
+    if (channelSocket == nullptr)
+    {
+        return SocketResult::fromErrno(ENOTCONN);
+    }
+    SocketResult result = track(channelSocket->receive(a_buffer, a_length));
+    if (latency)
+    {
+        replyReceived(result.ok() && result.bytes > 0);
+    }
+    return result;
+}
+
+void ClientChannel::enableLatencyTracking(bool a_enable)
+{
+    /* Turning it on again starts from an empty histogram*/
+    if (a_enable)
+    {
+        latency.reset(new LatencyRecorder());
+        sentAt.assign(MAX_UNANSWERED, 0);
+    }
+    else
+    {
+        latency.reset();
+    }
+    sentHead = 0;
+    sentCount = 0;
+}
+
+LatencyHistogram ClientChannel::latencySnapshot() const
+{
+    return latency ? latency->snapshot() : LatencyHistogram();
+}
+
+void ClientChannel::setFraming(FramingType a_framing)
+{
+    /* A pooled connection keeps the pool's framing (see ConnectionPool::setFraming)*/
+    if (pool == nullptr)
+    {
+        channelSocket->setFraming(a_framing);
+    }
+}
+
+void ClientChannel::setTimeouts(const SocketTimeouts &a_timeouts)
+{
+    /* A pooled connection only gets them while it is borrowed*/
+    if (channelSocket != nullptr)
+    {
+        channelSocket->setTimeouts(a_timeouts);
+    }
+}
+
+SocketResult ClientChannel::setTuning(const SocketTuning &a_tuning)
+{
+    /* Pooled connections get the pool's tuning (see ConnectionPool::setTuning)*/
+    if (pool != nullptr)
+    {
+        return SocketResult(SocketStatus::ERROR, 0, EOPNOTSUPP);
+    }
+    return channelSocket->setTuning(a_tuning);
+}
+
+void ClientChannel::flush()
+{
+    if (channelSocket != nullptr)
+    {
+        channelSocket->flush();
+    }
+}
+
+SocketCounters ClientChannel::stats() const
+{
+    if (pool == nullptr)
+    {
+        return Channel::stats();
+    }
+    SocketCounters counters = returnedCounters;
+    if (pooledConnection != nullptr)
+    {
+        SocketCounters borrowed = pooledConnection->stats();
+        borrowed -= borrowedBaseline;
+        counters += borrowed;
+    }
+    return counters;
 }
 
 void ClientChannel::stop() 
 {
+    if (channelStatus == ChannelStatusType::CHANNEL_ON && pool != nullptr)
+    {
+        /* Back to the pool (health-checked there), or closed after a failure*/
+        returnedCounters = stats();
+        pool->release(pooledConnection, reusable);
+        pooledConnection = nullptr;
+        channelSocket = nullptr;
+        channelStatus = ChannelStatusType::CHANNEL_OFF;
+        return;
+    }
     if (channelStatus == ChannelStatusType::CHANNEL_ON)
     {
         if (channelSocket != nullptr)
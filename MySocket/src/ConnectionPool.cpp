@@ -0,0 +1,188 @@
+#include "ConnectionPool.hpp"
+
+ConnectionPool::ConnectionPool(const std::string a_ip, int a_port, size_t a_poolSize)
+    : ip(a_ip), port(a_port), poolSize(a_poolSize > 0 ? a_poolSize : 1) {}
+
+void ConnectionPool::setTimeouts(const SocketTimeouts &a_timeouts)
+{
+    std::lock_guard<std::mutex> guard(lock);
+    timeouts = a_timeouts;
+}
+
+void ConnectionPool::setFraming(FramingType a_framing)
+{
+    std::lock_guard<std::mutex> guard(lock);
+    framing = a_framing;
+}
+
+void ConnectionPool::setFastOpen(bool a_enable)
+{
+    std::lock_guard<std::mutex> guard(lock);
+    fastOpen = a_enable;
+}
+
+void ConnectionPool::setTuning(const SocketTuning &a_tuning)
+{
+    std::lock_guard<std::mutex> guard(lock);
+    tuning = a_tuning;
+}
+
+SocketResult ConnectionPool::connectNew(TCPSocket *&a_connection)
+{
+    /* Called without the lock held: a connect may take up to timeouts.connectMs*/
+    SocketTimeouts connectionTimeouts;
+    FramingType connectionFraming;
+    bool connectionFastOpen;
+    SocketTuning connectionTuning;
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        connectionTimeouts = timeouts;
+        connectionFraming = framing;
+        connectionFastOpen = fastOpen;
+        connectionTuning = tuning;
+    }
+
+    TCPSocket *connection = new TCPSocket();
+    connection->setTimeouts(connectionTimeouts);
+    connection->setFraming(connectionFraming);
+    if (!connectionTuning.isDefault())
+    {
+        connection->setTuning(connectionTuning);
+    }
+    if (connectionFastOpen)
+    {
+        /* Not fatal: without kernel support the connection just uses the normal handshake*/
+        connection->enableFastOpenConnect();
+    }
+    SocketResult result = connection->connect(ip, port);
+    if (!result.ok())
+    {
+        connection->shutdown();
+        delete connection;
+        a_connection = nullptr;
+        return result;
+    }
+    a_connection = connection;
+    return result;
+}
+
+SocketResult ConnectionPool::warmUp()
+{
+    /*
+     * Connects until poolSize connections are idle, e.g. at startup or after a burst of failures.
+     * Stops at the first failed connect and returns its result.
+     */
+    while (idleCount() < poolSize)
+    {
+        TCPSocket *connection;
+        SocketResult result = connectNew(connection);
+        if (!result.ok())
+        {
+            return result;
+        }
+        std::lock_guard<std::mutex> guard(lock);
+        idle.push_back(connection);
+    }
+    return SocketResult::success();
+}
+
+SocketResult ConnectionPool::acquire(TCPSocket *&a_connection)
+{
+    /*
+     ! Most recently used first:
+     * The connection released last is the least likely to have been closed by an idle timeout
+     * on the server. Connections failing the health check are closed and the next one is tried.
+     */
+    while (true)
+    {
+        TCPSocket *connection = nullptr;
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            if (idle.empty())
+            {
+                break;
+            }
+            connection = idle.back();
+            idle.pop_back();
+        }
+        if (connection->isReusable())
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            reused++;
+            a_connection = connection;
+            return SocketResult::success();
+        }
+        connection->shutdown();
+        delete connection;
+    }
+
+    /* Pool miss: a fresh connection (owned by the caller like any acquired one)*/
+    SocketResult result = connectNew(a_connection);
+    if (result.ok())
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        connected++;
+    }
+    return result;
+}
+
+void ConnectionPool::release(TCPSocket *a_connection, bool a_reusable)
+{
+    /*
+     * a_reusable = false when the user saw a timeout or an error mid-message: the stream position
+     * is unknown, so the connection must not be handed to the next user.
+     */
+    if (a_connection == nullptr)
+    {
+        return;
+    }
+    if (a_reusable && a_connection->isReusable())
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        if (idle.size() < poolSize)
+        {
+            idle.push_back(a_connection);
+            return;
+        }
+    }
+    a_connection->shutdown();
+    delete a_connection;
+}
+
+void ConnectionPool::clear()
+{
+    std::deque<TCPSocket *> closing;
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        closing.swap(idle);
+    }
+    for (TCPSocket *connection : closing)
+    {
+        connection->shutdown();
+        delete connection;
+    }
+}
+
+size_t ConnectionPool::idleCount() const
+{
+    std::lock_guard<std::mutex> guard(lock);
+    return idle.size();
+}
+
+size_t ConnectionPool::reusedCount() const
+{
+    std::lock_guard<std::mutex> guard(lock);
+    return reused;
+}
+
+size_t ConnectionPool::connectedCount() const
+{
+    std::lock_guard<std::mutex> guard(lock);
+    return connected;
+}
+
+// Destructor for ConnectionPool
+ConnectionPool::~ConnectionPool()
+{
+    clear(); // Close every idle connection, acquired ones belong to their users
+}
@@ -0,0 +1,121 @@
+#include "DatagramBatch.hpp"
+#include <netinet/udp.h> // For UDP_GRO
+#include <algorithm>
+#include <cstring>
+
+/* Room for the one control message UDP_GRO adds (the segment size as an int)*/
+static const size_t CONTROL_SPACE = CMSG_SPACE(sizeof(int));
+
+DatagramBatch::DatagramBatch(size_t a_capacity, size_t a_slotSize)
+    : slotSize(a_slotSize), storage(a_capacity * a_slotSize), segments(a_capacity), headers(a_capacity), senders(a_capacity),
+      controls(a_capacity * CONTROL_SPACE), segmentSizes(a_capacity), received(0)
+{
+    /*
+     ! Wiring the slots once:
+     * headers[i].msg_hdr points at senders[i] (msg_name) and segments[i] (msg_iov),
+     * segments[i] points at the i-th slotSize chunk of storage.
+     * The vectors are never resized afterwards, so the pointers stay valid.
+     */
+    memset(headers.data(), 0, headers.size() * sizeof(struct mmsghdr));
+    for (size_t i = 0; i < a_capacity; i++)
+    {
+        segments[i].iov_base = storage.data() + i * slotSize;
+        segments[i].iov_len = slotSize;
+        headers[i].msg_hdr.msg_name = &senders[i];
+        headers[i].msg_hdr.msg_iov = &segments[i];
+        headers[i].msg_hdr.msg_iovlen = 1;
+        headers[i].msg_hdr.msg_control = controls.data() + i * CONTROL_SPACE;
+    }
+}
+
+void DatagramBatch::prepare()
+{
+    /* recvmmsg overwrites the in/out fields, they are reset before each call*/
+    for (size_t i = 0; i < headers.size(); i++)
+    {
+        headers[i].msg_hdr.msg_namelen = sizeof(struct sockaddr_in);
+        headers[i].msg_hdr.msg_controllen = CONTROL_SPACE;
+        headers[i].msg_hdr.msg_flags = 0;
+        headers[i].msg_len = 0;
+    }
+    received = 0;
+}
+
+void DatagramBatch::parseSegments(size_t a_count)
+{
+    /* A coalesced slot carries a UDP_GRO control message with the size of its segments*/
+    for (size_t i = 0; i < a_count; i++)
+    {
+        segmentSizes[i] = headers[i].msg_len;
+        struct msghdr &header = headers[i].msg_hdr;
+        for (struct cmsghdr *control = CMSG_FIRSTHDR(&header); control != nullptr; control = CMSG_NXTHDR(&header, control))
+        {
+            if (control->cmsg_level == SOL_UDP && control->cmsg_type == UDP_GRO)
+            {
+                int size;
+                memcpy(&size, CMSG_DATA(control), sizeof(size));
+                if (size > 0)
+                {
+                    segmentSizes[i] = (size_t)size;
+                }
+            }
+        }
+    }
+}
+
+size_t DatagramBatch::capacity() const
+{
+    return headers.size();
+}
+
+size_t DatagramBatch::size() const
+{
+    return received;
+}
+
+const char *DatagramBatch::data(size_t a_index) const
+{
+    return storage.data() + a_index * slotSize;
+}
+
+size_t DatagramBatch::length(size_t a_index) const
+{
+    return headers[a_index].msg_len;
+}
+
+bool DatagramBatch::truncated(size_t a_index) const
+{
+    /* MSG_TRUNC in msg_flags: the datagram was longer than slotSize and the rest was discarded*/
+    return (headers[a_index].msg_hdr.msg_flags & MSG_TRUNC) != 0;
+}
+
+const struct sockaddr_in &DatagramBatch::sender(size_t a_index) const
+{
+    return senders[a_index];
+}
+
+size_t DatagramBatch::segmentSize(size_t a_index) const
+{
+    return segmentSizes[a_index];
+}
+
+size_t DatagramBatch::segmentCount(size_t a_index) const
+{
+    size_t length = headers[a_index].msg_len;
+    if (segmentSizes[a_index] == 0)
+    {
+        return 1; /* An empty datagram is still one datagram*/
+    }
+    return std::max<size_t>((length + segmentSizes[a_index] - 1) / segmentSizes[a_index], 1);
+}
+
+const char *DatagramBatch::segment(size_t a_index, size_t a_segment) const
+{
+    return data(a_index) + a_segment * segmentSizes[a_index];
+}
+
+size_t DatagramBatch::segmentLength(size_t a_index, size_t a_segment) const
+{
+    size_t offset = a_segment * segmentSizes[a_index];
+    return std::min(segmentSizes[a_index], headers[a_index].msg_len - offset);
+}
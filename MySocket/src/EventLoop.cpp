@@ -0,0 +1,214 @@
+#include "EventLoop.hpp"
+#include <sys/eventfd.h> // For eventfd
+#include <chrono>
+#include <iostream>
+#include <cerrno>
+#include <unistd.h>
+
+EventLoop::EventLoop(int a_maxEventsPerWait) : stopRequested(false), wakeFD(-1), readyEvents(a_maxEventsPerWait > 0 ? a_maxEventsPerWait : 1),
+                                              timers(nowNanoseconds() / 1000000)
+{
+    /*
+     ! epoll_create1(EPOLL_CLOEXEC):
+     * Creates the epoll instance. Unlike select/poll, the interest list lives in the kernel,
+     * so the cost of a wait is proportional to the number of ready descriptors,
+     * not the number of watched ones (this is what makes 10k+ connections per thread practical).
+     */
+    epollFD = epoll_create1(EPOLL_CLOEXEC);
+    if (epollFD < 0)
+    {
+        /**
+         *! THROW
+         */
+        std::cerr << "epoll creation failed!" << std::endl;
+        return;
+    }
+
+    /*
+     ! eventfd wakeup:
+     * stop() and wakeup() may be called from other threads (e.g. to shut down worker loops).
+     * Writing to the eventfd makes epoll_wait return, the callback just drains the counter.
+     */
+    wakeFD = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (wakeFD >= 0)
+    {
+        add(wakeFD, EPOLLIN, [this](uint32_t)
+            {
+                uint64_t count;
+                while (read(wakeFD, &count, sizeof(count)) > 0)
+                {
+                } });
+    }
+}
+
+bool EventLoop::add(int a_fd, uint32_t a_events, EventCallback a_callback)
+{
+    struct epoll_event event;
+    event.events = a_events;
+    event.data.fd = a_fd;
+
+    if (epoll_ctl(epollFD, EPOLL_CTL_ADD, a_fd, &event) < 0)
+    {
+        /**
+         *! THROW
+         */
+        std::cerr << "Failed to add descriptor to epoll!" << std::endl;
+        return false;
+    }
+    callbacks[a_fd] = std::make_shared<EventCallback>(std::move(a_callback));
+    return true;
+}
+
+bool EventLoop::modify(int a_fd, uint32_t a_events)
+{
+    struct epoll_event event;
+    event.events = a_events;
+    event.data.fd = a_fd;
+
+    if (epoll_ctl(epollFD, EPOLL_CTL_MOD, a_fd, &event) < 0)
+    {
+        /**
+         *! THROW
+         */
+        std::cerr << "Failed to modify epoll registration!" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+void EventLoop::remove(int a_fd)
+{
+    /* Must be called before the descriptor is closed, a closed fd can't be removed from epoll explicitly*/
+    if (callbacks.erase(a_fd) > 0)
+    {
+        epoll_ctl(epollFD, EPOLL_CTL_DEL, a_fd, nullptr);
+    }
+}
+
+bool EventLoop::isWatching(int a_fd) const
+{
+    return callbacks.find(a_fd) != callbacks.end();
+}
+
+uint64_t EventLoop::nowNanoseconds()
+{
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+uint64_t EventLoop::tickAfter(uint64_t a_delayMs) const
+{
+    /* Rounded up to the next whole millisecond, so the timer can't fire before a_delayMs have passed*/
+    return (nowNanoseconds() + a_delayMs * 1000000 + 999999) / 1000000;
+}
+
+EventLoop::TimerId EventLoop::addTimer(uint64_t a_delayMs, TimerCallback a_callback)
+{
+    return timers.schedule(tickAfter(a_delayMs), 0, std::move(a_callback));
+}
+
+EventLoop::TimerId EventLoop::addPeriodicTimer(uint64_t a_periodMs, TimerCallback a_callback)
+{
+    uint64_t period = (a_periodMs > 0) ? a_periodMs : 1;
+    return timers.schedule(tickAfter(period), period, std::move(a_callback));
+}
+
+bool EventLoop::rescheduleTimer(TimerId a_id, uint64_t a_delayMs)
+{
+    return timers.reschedule(a_id, tickAfter(a_delayMs));
+}
+
+bool EventLoop::cancelTimer(TimerId a_id)
+{
+    return timers.cancel(a_id);
+}
+
+size_t EventLoop::timerCount() const
+{
+    return timers.size();
+}
+
+int EventLoop::runOnce(int a_timeoutMs)
+{
+    /* Sleep no longer than until the wheel has something to do*/
+    int timeoutMs = a_timeoutMs;
+    int64_t ticks = timers.ticksUntilNext();
+    if (ticks >= 0)
+    {
+        uint64_t dueNs = (timers.now() + (uint64_t)ticks) * 1000000;
+        uint64_t nowNs = nowNanoseconds();
+        int64_t waitMs = (dueNs > nowNs) ? (int64_t)((dueNs - nowNs + 999999) / 1000000) : 0;
+        if (timeoutMs < 0 || waitMs < timeoutMs)
+        {
+            timeoutMs = (int)waitMs;
+        }
+    }
+
+    int ready = epoll_wait(epollFD, readyEvents.data(), (int)readyEvents.size(), timeoutMs);
+    if (ready < 0)
+    {
+        if (errno != EINTR)
+        {
+            /**
+             *! THROW
+             */
+            std::cerr << "epoll_wait failed!" << std::endl;
+        }
+        return (int)timers.advance(nowNanoseconds() / 1000000);
+    }
+
+    for (int i = 0; i < ready; i++)
+    {
+        /*
+         ~ The callback is looked up per event instead of being stored in epoll_event.data,
+         ~ so an event for a descriptor removed earlier in this batch is skipped.
+         */
+        auto entry = callbacks.find(readyEvents[i].data.fd);
+        if (entry == callbacks.end())
+        {
+            continue;
+        }
+        std::shared_ptr<EventCallback> callback = entry->second;
+        (*callback)(readyEvents[i].events);
+    }
+    return ready + (int)timers.advance(nowNanoseconds() / 1000000);
+}
+
+void EventLoop::run()
+{
+    /* A stop() issued before run() started is honoured, the flag is re-armed on exit so the loop can run again*/
+    while (!stopRequested.load(std::memory_order_acquire))
+    {
+        runOnce(-1);
+    }
+    stopRequested.store(false, std::memory_order_release);
+}
+
+void EventLoop::stop()
+{
+    stopRequested.store(true, std::memory_order_release);
+    wakeup();
+}
+
+void EventLoop::wakeup()
+{
+    if (wakeFD >= 0)
+    {
+        uint64_t one = 1;
+        ssize_t written = write(wakeFD, &one, sizeof(one));
+        (void)written; /* EAGAIN only means a wakeup is already pending*/
+    }
+}
+
+EventLoop::~EventLoop()
+{
+    if (wakeFD >= 0)
+    {
+        close(wakeFD);
+        wakeFD = -1;
+    }
+    if (epollFD >= 0)
+    {
+        close(epollFD);
+        epollFD = -1;
+    }
+}
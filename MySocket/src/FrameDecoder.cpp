@@ -0,0 +1,115 @@
+#include "FrameDecoder.hpp"
+#include <cstring>
+
+FrameDecoder::FrameDecoder(uint32_t a_maxFrameSize) : buffer(4096), readOffset(0), writeOffset(0), maxFrameSize(a_maxFrameSize), corrupted(false) {}
+
+char *FrameDecoder::prepare(size_t a_minSpace)
+{
+    /*
+     * Makes at least a_minSpace bytes writable after writeOffset:
+     *  1- Everything consumed: rewind to the start of the buffer (the common case, no copy).
+     *  2- Not enough tail space: move the unconsumed partial frame to the front.
+     *  3- Still not enough: grow the buffer (it keeps its size afterwards).
+     */
+    if (readOffset == writeOffset)
+    {
+        readOffset = writeOffset = 0;
+    }
+    if (buffer.size() - writeOffset < a_minSpace && readOffset > 0)
+    {
+        memmove(buffer.data(), buffer.data() + readOffset, writeOffset - readOffset);
+        writeOffset -= readOffset;
+        readOffset = 0;
+    }
+    if (buffer.size() - writeOffset < a_minSpace)
+    {
+        size_t newSize = buffer.size() * 2;
+        while (newSize - writeOffset < a_minSpace)
+        {
+            newSize *= 2;
+        }
+        buffer.resize(newSize);
+    }
+    return buffer.data() + writeOffset;
+}
+
+size_t FrameDecoder::writableSize() const
+{
+    return buffer.size() - writeOffset;
+}
+
+void FrameDecoder::commit(size_t a_bytes)
+{
+    writeOffset += a_bytes;
+}
+
+void FrameDecoder::feed(const char *a_data, size_t a_length)
+{
+    memcpy(prepare(a_length), a_data, a_length);
+    commit(a_length);
+}
+
+uint32_t FrameDecoder::headerLength() const
+{
+    const unsigned char *header = (const unsigned char *)buffer.data() + readOffset;
+    return ((uint32_t)header[0] << 24) | ((uint32_t)header[1] << 16) | ((uint32_t)header[2] << 8) | (uint32_t)header[3];
+}
+
+bool FrameDecoder::hasFrame() const
+{
+    size_t available = writeOffset - readOffset;
+    if (corrupted || available < HEADER_SIZE)
+    {
+        return false;
+    }
+    uint32_t length = headerLength();
+    if (length > maxFrameSize)
+    {
+        corrupted = true; /* Boundaries are lost for good: the caller has to drop the connection*/
+        return false;
+    }
+    return available - HEADER_SIZE >= length;
+}
+
+size_t FrameDecoder::nextFrameLength() const
+{
+    /* Payload length of the next complete frame (0 if none is complete yet)*/
+    return hasFrame() ? headerLength() : 0;
+}
+
+bool FrameDecoder::nextFrame(const char *&a_data, size_t &a_length)
+{
+    if (!hasFrame())
+    {
+        return false;
+    }
+    a_length = headerLength();
+    a_data = buffer.data() + readOffset + HEADER_SIZE;
+    readOffset += HEADER_SIZE + a_length;
+    return true;
+}
+
+size_t FrameDecoder::bufferedBytes() const
+{
+    return writeOffset - readOffset;
+}
+
+bool FrameDecoder::isCorrupted() const
+{
+    return corrupted;
+}
+
+void FrameDecoder::reset()
+{
+    readOffset = writeOffset = 0;
+    corrupted = false;
+}
+
+void FrameDecoder::encodeHeader(uint32_t a_payloadLength, char a_header[HEADER_SIZE])
+{
+    /* htonl by hand so the header is written byte by byte regardless of alignment*/
+    a_header[0] = (char)((a_payloadLength >> 24) & 0xFF);
+    a_header[1] = (char)((a_payloadLength >> 16) & 0xFF);
+    a_header[2] = (char)((a_payloadLength >> 8) & 0xFF);
+    a_header[3] = (char)(a_payloadLength & 0xFF);
+}
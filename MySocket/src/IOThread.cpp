@@ -0,0 +1,246 @@
+#include "IOThread.hpp"
+#include <sys/eventfd.h> // For eventfd
+#include <algorithm>
+
+IOThread::Inbox::Inbox(IOThread &a_owner, Socket *a_socket, size_t a_capacity, size_t a_maxMessageSize)
+    : owner(a_owner), socket(a_socket), ring(a_capacity), paused(false), closed(false), waiting(false)
+{
+    /* Every slot gets its payload buffer now, the I/O thread receives straight into it*/
+    for (size_t i = 0; i < ring.capacity(); i++)
+    {
+        ring.slot(i).data.resize(a_maxMessageSize);
+    }
+    if (dynamic_cast<UDPSocket *>(socket) != nullptr)
+    {
+        datagrams.reset(new DatagramBatch(64, a_maxMessageSize));
+    }
+    readyFD = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+}
+
+const IOThread::Message *IOThread::Inbox::front()
+{
+    return ring.front();
+}
+
+void IOThread::Inbox::pop()
+{
+    ring.consume();
+
+    /*
+     * Pairs with the fence in drain(): either the I/O thread sees the freed slot when it
+     * re-checks after pausing, or this thread sees paused and wakes it up.
+     */
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (paused.load(std::memory_order_relaxed))
+    {
+        owner.loop.wakeup();
+    }
+}
+
+bool IOThread::Inbox::wait(int a_timeoutMs)
+{
+    /*
+     ! Sleeping handler:
+     * The I/O thread only writes the eventfd when waiting is set, so a busy handler
+     * costs the I/O thread no system call per message.
+     */
+    if (ring.front() != nullptr)
+    {
+        return true;
+    }
+    waiting.store(true, std::memory_order_seq_cst);
+    if (ring.front() == nullptr && !closed.load(std::memory_order_acquire))
+    {
+        struct pollfd waitFor = {readyFD, POLLIN, 0};
+        ::poll(&waitFor, 1, a_timeoutMs);
+        uint64_t count;
+        while (read(readyFD, &count, sizeof(count)) > 0)
+        {
+        }
+    }
+    waiting.store(false, std::memory_order_relaxed);
+    return ring.front() != nullptr;
+}
+
+size_t IOThread::Inbox::size() const
+{
+    return ring.size();
+}
+
+bool IOThread::Inbox::isClosed() const
+{
+    return closed.load(std::memory_order_acquire);
+}
+
+IOThread::Inbox::~Inbox()
+{
+    if (readyFD >= 0)
+    {
+        close(readyFD);
+        readyFD = -1;
+    }
+}
+
+IOThread::IOThread() : running(false) {}
+
+IOThread::Inbox &IOThread::attach(Channel &a_channel, size_t a_capacity, size_t a_maxMessageSize)
+{
+    /*
+     * A zero receive deadline turns every receive into "what is there now": the I/O thread reads
+     * until TIMEOUT without blocking, even for a frame that is only partly received.
+     */
+    Socket *socket = a_channel.getSocket();
+    SocketTimeouts timeouts = socket->getTimeouts();
+    timeouts.receiveMs = 0;
+    socket->setTimeouts(timeouts);
+
+    inboxes.emplace_back(new Inbox(*this, socket, a_capacity, a_maxMessageSize));
+    Inbox *inbox = inboxes.back().get();
+    loop.add(socket->getFD(), EPOLLIN, [this, inbox](uint32_t)
+             { drain(*inbox); });
+    return *inbox;
+}
+
+void IOThread::drain(Inbox &a_inbox)
+{
+    /*
+     ! Kernel drain:
+     * Everything the socket has is moved into the ring (stream sockets may deliver several frames
+     * per read, which are then taken from the decoder without system calls).
+     */
+    bool published = false;
+    while (true)
+    {
+        if (a_inbox.datagrams && !drainDatagrams(a_inbox, published))
+        {
+            break;
+        }
+        Message *slot = a_inbox.ring.claim();
+        if (slot == nullptr)
+        {
+            /* Full: stop watching the socket until the handler pops (see Inbox::pop)*/
+            a_inbox.paused.store(true, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (a_inbox.ring.claim() != nullptr)
+            {
+                a_inbox.paused.store(false, std::memory_order_relaxed);
+                continue;
+            }
+            loop.remove(a_inbox.socket->getFD());
+            break;
+        }
+
+        SocketResult result = a_inbox.socket->receive(slot->data.data(), slot->data.size());
+        if (result.status == SocketStatus::TIMEOUT || result.status == SocketStatus::WOULD_BLOCK)
+        {
+            break;
+        }
+        slot->length = result.bytes;
+        slot->status = result.status;
+        slot->errorNumber = result.errorNumber;
+        a_inbox.ring.publish();
+        published = true;
+        if (!result.ok())
+        {
+            /* End of stream (peer closed, reset, or a frame larger than maxMessageSize)*/
+            a_inbox.closed.store(true, std::memory_order_release);
+            loop.remove(a_inbox.socket->getFD());
+            break;
+        }
+    }
+
+    if (published)
+    {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (a_inbox.waiting.load(std::memory_order_relaxed))
+        {
+            uint64_t one = 1;
+            ssize_t written = write(a_inbox.readyFD, &one, sizeof(one));
+            (void)written;
+        }
+    }
+}
+
+bool IOThread::drainDatagrams(Inbox &a_inbox, bool &a_published)
+{
+    /*
+     * UDP: up to 64 datagrams per recvmmsg, never more than the ring can take, so the
+     * kernel queue empties with a fraction of the system calls. Returns true when the ring
+     * is full and the socket may still hold data (drain() then pauses the inbox).
+     */
+    while (true)
+    {
+        size_t space = a_inbox.ring.capacity() - a_inbox.ring.size();
+        if (space == 0)
+        {
+            return true;
+        }
+        UDPSocket *socket = static_cast<UDPSocket *>(a_inbox.socket);
+        SocketResult result = socket->receiveBatch(*a_inbox.datagrams, false, space);
+        if (!result.ok() || result.bytes == 0)
+        {
+            return false;
+        }
+        for (size_t i = 0; i < result.bytes; i++)
+        {
+            Message *slot = a_inbox.ring.claim();
+            size_t length = std::min(a_inbox.datagrams->length(i), slot->data.size());
+            memcpy(slot->data.data(), a_inbox.datagrams->data(i), length);
+            slot->length = length;
+            slot->status = SocketStatus::OK;
+            slot->errorNumber = 0;
+            slot->sender = a_inbox.datagrams->sender(i);
+            a_inbox.ring.publish();
+        }
+        a_published = true;
+    }
+}
+
+void IOThread::resumePaused()
+{
+    for (std::unique_ptr<Inbox> &inbox : inboxes)
+    {
+        if (inbox->paused.load(std::memory_order_relaxed) && inbox->ring.claim() != nullptr)
+        {
+            inbox->paused.store(false, std::memory_order_relaxed);
+            Inbox *target = inbox.get();
+            loop.add(target->socket->getFD(), EPOLLIN, [this, target](uint32_t)
+                     { drain(*target); });
+
+            /* Frames already in the decoder produce no epoll event*/
+            drain(*target);
+        }
+    }
+}
+
+void IOThread::start()
+{
+    if (running.load())
+    {
+        return;
+    }
+    running.store(true);
+    thread = std::thread([this]()
+                         {
+                             while (running.load(std::memory_order_acquire))
+                             {
+                                 loop.runOnce(-1);
+                                 resumePaused();
+                             } });
+}
+
+void IOThread::stop()
+{
+    if (thread.joinable())
+    {
+        running.store(false, std::memory_order_release);
+        loop.wakeup();
+        thread.join();
+    }
+}
+
+// Destructor for IOThread
+IOThread::~IOThread()
+{
+    stop(); // The thread must be gone before the inboxes it fills
+}
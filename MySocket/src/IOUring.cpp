@@ -0,0 +1,340 @@
+#include "IOUring.hpp"
+#include <sys/mman.h>    // For mmap and munmap
+#include <sys/syscall.h> // For __NR_io_uring_setup and __NR_io_uring_enter
+#include <unistd.h>
+#include <poll.h>        // For poll on the ring descriptor
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+
+IOUring::IOUring(unsigned a_entries)
+    : ringFD(-1), sqRing(MAP_FAILED), cqRing(MAP_FAILED), sqRingSize(0), cqRingSize(0), sqes(nullptr), sqesSize(0),
+      sqHead(nullptr), sqTail(nullptr), sqMask(nullptr), sqArray(nullptr), sqEntries(0),
+      cqHead(nullptr), cqTail(nullptr), cqMask(nullptr), cqes(nullptr), localTail(0), inFlight(0)
+{
+    /*
+     ! 1 - Creating the ring:
+     * io_uring_setup allocates a submission queue of a_entries slots (rounded up to a power of 2)
+     * and a completion queue (twice as large by default) and fills params with the offsets of
+     * the head/tail/mask/array fields inside the memory that has to be mapped next.
+     */
+    struct io_uring_params params;
+    memset(&params, 0, sizeof(params));
+    ringFD = (int)syscall(__NR_io_uring_setup, a_entries, &params);
+    if (ringFD < 0)
+    {
+        /**
+         *! THROW
+         */
+        std::cerr << "io_uring setup failed, falling back to blocking I/O!" << std::endl;
+        return;
+    }
+
+    /*
+     ! 2 - Mapping the rings:
+     * With IORING_FEAT_SINGLE_MMAP (kernel 5.4+) the SQ and CQ rings share one mapping.
+     * The SQE array is always a separate mapping.
+     */
+    sqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+    bool singleMmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+    if (singleMmap)
+    {
+        sqRingSize = cqRingSize = (sqRingSize > cqRingSize) ? sqRingSize : cqRingSize;
+    }
+
+    sqRing = mmap(nullptr, sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFD, IORING_OFF_SQ_RING);
+    cqRing = singleMmap ? sqRing : mmap(nullptr, cqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFD, IORING_OFF_CQ_RING);
+    sqesSize = params.sq_entries * sizeof(struct io_uring_sqe);
+    void *sqesMapping = mmap(nullptr, sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFD, IORING_OFF_SQES);
+    if (sqRing == MAP_FAILED || cqRing == MAP_FAILED || sqesMapping == MAP_FAILED)
+    {
+        /**
+         *! THROW
+         */
+        std::cerr << "io_uring mmap failed, falling back to blocking I/O!" << std::endl;
+        if (sqesMapping != MAP_FAILED)
+        {
+            munmap(sqesMapping, sqesSize);
+        }
+        if (cqRing != MAP_FAILED && cqRing != sqRing)
+        {
+            munmap(cqRing, cqRingSize);
+        }
+        if (sqRing != MAP_FAILED)
+        {
+            munmap(sqRing, sqRingSize);
+        }
+        sqRing = cqRing = MAP_FAILED;
+        close(ringFD);
+        ringFD = -1;
+        return;
+    }
+    sqes = (struct io_uring_sqe *)sqesMapping;
+
+    char *sq = (char *)sqRing;
+    sqHead = (unsigned *)(sq + params.sq_off.head);
+    sqTail = (unsigned *)(sq + params.sq_off.tail);
+    sqMask = (unsigned *)(sq + params.sq_off.ring_mask);
+    sqArray = (unsigned *)(sq + params.sq_off.array);
+    sqEntries = params.sq_entries;
+
+    char *cq = (char *)cqRing;
+    cqHead = (unsigned *)(cq + params.cq_off.head);
+    cqTail = (unsigned *)(cq + params.cq_off.tail);
+    cqMask = (unsigned *)(cq + params.cq_off.ring_mask);
+    cqes = (struct io_uring_cqe *)(cq + params.cq_off.cqes);
+
+    localTail = *sqTail;
+}
+
+IOUring &IOUring::threadRing()
+{
+    /* One ring per thread: sockets used from the same thread share its submission batches*/
+    thread_local IOUring ring;
+    return ring;
+}
+
+bool IOUring::isReady() const
+{
+    return ringFD >= 0;
+}
+
+struct io_uring_sqe *IOUring::nextSqe(int a_fd, uint8_t a_opcode, Request *a_request)
+{
+    /*
+     * The SQ is full when the kernel hasn't consumed (head) what we prepared (localTail),
+     * in which case the prepared batch is submitted first to make room.
+     */
+    if (localTail - __atomic_load_n(sqHead, __ATOMIC_ACQUIRE) >= sqEntries)
+    {
+        submit();
+    }
+
+    unsigned index = localTail & *sqMask;
+    struct io_uring_sqe *sqe = &sqes[index];
+    memset(sqe, 0, sizeof(*sqe));
+    sqe->opcode = a_opcode;
+    sqe->fd = a_fd;
+    sqe->user_data = (uint64_t)(uintptr_t)a_request;
+    sqArray[index] = index;
+    localTail++;
+    inFlight++;
+
+    if (a_request != nullptr)
+    {
+        a_request->completed = false;
+        a_request->result = 0;
+    }
+    return sqe;
+}
+
+void IOUring::prepareSend(int a_fd, const void *a_buffer, size_t a_length, int a_flags, Request *a_request)
+{
+    struct io_uring_sqe *sqe = nextSqe(a_fd, IORING_OP_SEND, a_request);
+    sqe->addr = (uint64_t)(uintptr_t)a_buffer;
+    sqe->len = (uint32_t)a_length;
+    sqe->msg_flags = (uint32_t)a_flags;
+}
+
+void IOUring::prepareSendMsg(int a_fd, const struct msghdr *a_message, int a_flags, Request *a_request)
+{
+    struct io_uring_sqe *sqe = nextSqe(a_fd, IORING_OP_SENDMSG, a_request);
+    sqe->addr = (uint64_t)(uintptr_t)a_message;
+    sqe->len = 1;
+    sqe->msg_flags = (uint32_t)a_flags;
+}
+
+void IOUring::prepareRecv(int a_fd, void *a_buffer, size_t a_length, int a_flags, Request *a_request)
+{
+    struct io_uring_sqe *sqe = nextSqe(a_fd, IORING_OP_RECV, a_request);
+    sqe->addr = (uint64_t)(uintptr_t)a_buffer;
+    sqe->len = (uint32_t)a_length;
+    sqe->msg_flags = (uint32_t)a_flags;
+}
+
+void IOUring::prepareRecvMsg(int a_fd, struct msghdr *a_message, int a_flags, Request *a_request)
+{
+    struct io_uring_sqe *sqe = nextSqe(a_fd, IORING_OP_RECVMSG, a_request);
+    sqe->addr = (uint64_t)(uintptr_t)a_message;
+    sqe->len = 1;
+    sqe->msg_flags = (uint32_t)a_flags;
+}
+
+void IOUring::prepareAccept(int a_fd, struct sockaddr *a_address, socklen_t *a_addressLength, int a_flags, Request *a_request)
+{
+    struct io_uring_sqe *sqe = nextSqe(a_fd, IORING_OP_ACCEPT, a_request);
+    sqe->addr = (uint64_t)(uintptr_t)a_address;
+    sqe->addr2 = (uint64_t)(uintptr_t)a_addressLength;
+    sqe->accept_flags = (uint32_t)a_flags;
+}
+
+unsigned IOUring::pendingSubmissions() const
+{
+    /*
+     * Counted from the kernel's SQ head, not from the published tail: entries that io_uring_enter
+     * didn't take (EAGAIN/EBUSY, or a short count) stay in the SQ and must be offered again.
+     */
+    return isReady() ? (localTail - __atomic_load_n(sqHead, __ATOMIC_ACQUIRE)) : 0;
+}
+
+unsigned IOUring::operationsInFlight() const
+{
+    return inFlight;
+}
+
+int IOUring::enter(unsigned a_toSubmit, unsigned a_minComplete)
+{
+    /*
+     ! io_uring_enter:
+     * Publishes the new SQ tail to the kernel (store-release so the SQE contents are visible first),
+     * submits a_toSubmit entries and, with IORING_ENTER_GETEVENTS, sleeps until at least
+     * a_minComplete completions are available. One system call for a whole batch.
+     * Returns the number of entries submitted, or -errno.
+     */
+    __atomic_store_n(sqTail, localTail, __ATOMIC_RELEASE);
+    unsigned flags = (a_minComplete > 0) ? IORING_ENTER_GETEVENTS : 0;
+    while (true)
+    {
+        int ret = (int)syscall(__NR_io_uring_enter, ringFD, a_toSubmit, a_minComplete, flags, nullptr, 0);
+        if (ret >= 0)
+        {
+            return ret;
+        }
+        int error = errno; /* Saved at once: -errno is returned, nothing in between may change it*/
+        if (error != EINTR)
+        {
+            return -error;
+        }
+    }
+}
+
+int IOUring::submit()
+{
+    if (!isReady())
+    {
+        return 0;
+    }
+    /*
+     * The kernel may take fewer entries than offered. Reaping frees CQ space (the usual cause of
+     * EBUSY), then the remainder is offered again while each call makes progress; what is still
+     * left goes with the next submit() or waitFor().
+     */
+    int submitted = 0;
+    while (pendingSubmissions() > 0)
+    {
+        int taken = enter(pendingSubmissions(), 0);
+        reapCompletions();
+        if (taken <= 0)
+        {
+            break;
+        }
+        submitted += taken;
+    }
+    reapCompletions();
+    return submitted;
+}
+
+unsigned IOUring::reapCompletions()
+{
+    if (!isReady())
+    {
+        return 0;
+    }
+    unsigned reaped = 0;
+    unsigned head = *cqHead;
+    while (head != __atomic_load_n(cqTail, __ATOMIC_ACQUIRE))
+    {
+        /*
+         * The entry is copied out and the head advanced before complete() runs,
+         * so a completion handler may prepare new operations on this ring.
+         */
+        struct io_uring_cqe cqe = cqes[head & *cqMask];
+        head++;
+        __atomic_store_n(cqHead, head, __ATOMIC_RELEASE);
+        inFlight--;
+        reaped++;
+
+        Request *request = (Request *)(uintptr_t)cqe.user_data;
+        if (request != nullptr)
+        {
+            request->complete(cqe.res);
+        }
+    }
+    return reaped;
+}
+
+void IOUring::waitFor(Request &a_request)
+{
+    /* Submits everything queued on the ring together with a_request and sleeps until it completes*/
+    reapCompletions();
+    while (!a_request.completed && isReady())
+    {
+        int ret = enter(pendingSubmissions(), 1);
+        if (ret < 0 && ret != -EBUSY && ret != -EAGAIN)
+        {
+            cancel(a_request, -ret);
+            return;
+        }
+        reapCompletions();
+    }
+}
+
+void IOUring::cancel(Request &a_request, int a_error)
+{
+    /*
+     * The request and the buffers/msghdr its SQE points at usually live in the caller's frame, so
+     * it can't be abandoned while the kernel may still use or report it:
+     *   not taken by the kernel yet : its SQE becomes a NOP without a request, it completes here.
+     *   taken (in flight)           : IORING_OP_ASYNC_CANCEL, then its own CQE is awaited, with poll()
+     *                                 on the ring when io_uring_enter keeps failing.
+     */
+    for (unsigned position = __atomic_load_n(sqHead, __ATOMIC_ACQUIRE); position != localTail; position++)
+    {
+        struct io_uring_sqe *sqe = &sqes[sqArray[position & *sqMask]];
+        if (sqe->user_data == (uint64_t)(uintptr_t)&a_request)
+        {
+            memset(sqe, 0, sizeof(*sqe));
+            sqe->opcode = IORING_OP_NOP;
+            a_request.complete(-a_error);
+            return;
+        }
+    }
+
+    struct io_uring_sqe *sqe = nextSqe(-1, IORING_OP_ASYNC_CANCEL, nullptr);
+    sqe->addr = (uint64_t)(uintptr_t)&a_request;
+    while (!a_request.completed && isReady())
+    {
+        int ret = enter(pendingSubmissions(), 1);
+        if (ret < 0)
+        {
+            struct pollfd waitFor = {ringFD, POLLIN, 0};
+            if (ret == -EBADF || (::poll(&waitFor, 1, 10) > 0 && (waitFor.revents & POLLNVAL)))
+            {
+                a_request.complete(-a_error); /* The ring is gone, the kernel cancelled everything on it*/
+                return;
+            }
+        }
+        reapCompletions();
+    }
+    if (a_request.result == -ECANCELED)
+    {
+        a_request.result = -a_error; /* The failure that made it cancelled*/
+    }
+}
+
+IOUring::~IOUring()
+{
+    if (ringFD >= 0)
+    {
+        /* Operations still in flight are cancelled by the kernel when the ring is closed*/
+        munmap(sqes, sqesSize);
+        if (cqRing != sqRing)
+        {
+            munmap(cqRing, cqRingSize);
+        }
+        munmap(sqRing, sqRingSize);
+        close(ringFD);
+        ringFD = -1;
+    }
+}
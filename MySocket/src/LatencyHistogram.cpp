@@ -0,0 +1,81 @@
+#include "LatencyHistogram.hpp"
+#include <algorithm>
+#include <cmath>
+
+uint64_t LatencyHistogram::bucketLowest(size_t a_index)
+{
+    if (a_index < 2 * SUB_BUCKET_COUNT)
+    {
+        return a_index;
+    }
+    unsigned shift = (unsigned)(a_index / SUB_BUCKET_COUNT) - 1;
+    uint64_t mantissa = a_index - shift * SUB_BUCKET_COUNT;
+    return mantissa << shift;
+}
+
+uint64_t LatencyHistogram::bucketHighest(size_t a_index)
+{
+    if (a_index < 2 * SUB_BUCKET_COUNT)
+    {
+        return a_index;
+    }
+    unsigned shift = (unsigned)(a_index / SUB_BUCKET_COUNT) - 1;
+    uint64_t mantissa = a_index - shift * SUB_BUCKET_COUNT;
+    return ((mantissa + 1) << shift) - 1;
+}
+
+LatencyHistogram::LatencyHistogram() : counts(BUCKET_COUNT, 0), total(0), sum(0), minimum(UINT64_MAX), maximum(0) {}
+
+void LatencyHistogram::record(uint64_t a_nanoseconds, uint64_t a_count)
+{
+    counts[bucketIndex(a_nanoseconds)] += a_count;
+    total += a_count;
+    sum += a_nanoseconds * a_count;
+    minimum = std::min(minimum, a_nanoseconds);
+    maximum = std::max(maximum, a_nanoseconds);
+}
+
+void LatencyHistogram::merge(const LatencyHistogram &a_other)
+{
+    for (size_t i = 0; i < BUCKET_COUNT; i++)
+    {
+        counts[i] += a_other.counts[i];
+    }
+    total += a_other.total;
+    sum += a_other.sum;
+    minimum = std::min(minimum, a_other.minimum);
+    maximum = std::max(maximum, a_other.maximum);
+}
+
+void LatencyHistogram::reset()
+{
+    std::fill(counts.begin(), counts.end(), 0);
+    total = 0;
+    sum = 0;
+    minimum = UINT64_MAX;
+    maximum = 0;
+}
+
+uint64_t LatencyHistogram::percentile(double a_percent) const
+{
+    if (total == 0)
+    {
+        return 0;
+    }
+    /*
+     * The rank of the value asked for, then the bucket that holds it. A bucket is reported by its
+     * highest value (never understating a tail), capped by the exact min/max.
+     */
+    double percent = std::min(std::max(a_percent, 0.0), 100.0);
+    uint64_t rank = std::max<uint64_t>((uint64_t)std::ceil(percent / 100.0 * total), 1);
+    uint64_t seen = 0;
+    for (size_t i = 0; i < BUCKET_COUNT; i++)
+    {
+        seen += counts[i];
+        if (seen >= rank)
+        {
+            return std::max(minimum, std::min(bucketHighest(i), maximum));
+        }
+    }
+    return maximum;
+}
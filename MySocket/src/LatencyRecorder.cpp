@@ -0,0 +1,33 @@
+#include "LatencyRecorder.hpp"
+
+LatencyRecorder::LatencyRecorder() : counts(new std::atomic<uint64_t>[LatencyHistogram::BUCKET_COUNT])
+{
+    reset();
+}
+
+void LatencyRecorder::reset()
+{
+    for (size_t i = 0; i < LatencyHistogram::BUCKET_COUNT; i++)
+    {
+        counts[i].store(0, std::memory_order_relaxed);
+    }
+    total.store(0, std::memory_order_relaxed);
+    sum.store(0, std::memory_order_relaxed);
+    minimum.store(UINT64_MAX, std::memory_order_relaxed);
+    maximum.store(0, std::memory_order_relaxed);
+}
+
+LatencyHistogram LatencyRecorder::snapshot() const
+{
+    /* The total is taken from the buckets copied, so percentiles stay consistent with them*/
+    LatencyHistogram histogram;
+    for (size_t i = 0; i < LatencyHistogram::BUCKET_COUNT; i++)
+    {
+        histogram.counts[i] = counts[i].load(std::memory_order_relaxed);
+        histogram.total += histogram.counts[i];
+    }
+    histogram.sum = sum.load(std::memory_order_relaxed);
+    histogram.minimum = minimum.load(std::memory_order_relaxed);
+    histogram.maximum = maximum.load(std::memory_order_relaxed);
+    return histogram;
+}
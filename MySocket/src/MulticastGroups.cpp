@@ -0,0 +1,49 @@
+#include "MulticastGroups.hpp"
+#include <arpa/inet.h> // For inet_pton
+#include <cstring>
+
+int MulticastGroups::add(const std::string &a_groupIP, int a_port)
+{
+    struct sockaddr_in destination;
+    memset(&destination, 0, sizeof(destination));
+    destination.sin_family = AF_INET;
+    destination.sin_port = htons(a_port);
+    if (inet_pton(AF_INET, a_groupIP.c_str(), &destination.sin_addr) <= 0 ||
+        !IN_MULTICAST(ntohl(destination.sin_addr.s_addr)))
+    {
+        return -1;
+    }
+    destinations.push_back(destination);
+    headers.emplace_back();
+    segments.emplace_back();
+    wire();
+    return (int)destinations.size() - 1;
+}
+
+void MulticastGroups::wire()
+{
+    /* Growing the vectors may move them, so every header is pointed at its address again*/
+    for (size_t i = 0; i < headers.size(); i++)
+    {
+        memset(&headers[i], 0, sizeof(struct mmsghdr));
+        headers[i].msg_hdr.msg_name = &destinations[i];
+        headers[i].msg_hdr.msg_namelen = sizeof(struct sockaddr_in);
+    }
+}
+
+void MulticastGroups::clear()
+{
+    destinations.clear();
+    headers.clear();
+    segments.clear();
+}
+
+size_t MulticastGroups::size() const
+{
+    return destinations.size();
+}
+
+const struct sockaddr_in &MulticastGroups::destination(size_t a_index) const
+{
+    return destinations[a_index];
+}
@@ -0,0 +1,400 @@
+#include "ReactorServerChannel.hpp"
+#include <algorithm>
+
+ReactorServerChannel::ReactorServerChannel(Socket *a_listenSocket, EventLoop &a_loop, int a_port, const std::string a_ip, TuningProfile a_profile)
+    : listenSocket(a_listenSocket), loop(a_loop), port(a_port), ip(a_ip),
+      lowWatermark(DEFAULT_LOW_WATERMARK), highWatermark(DEFAULT_HIGH_WATERMARK), acceptRetryTimer(0), started(false)
+{
+    /* Set on the listener, accepted connections inherit it*/
+    if (a_profile != TuningProfile::DEFAULT)
+    {
+        listenSocket->setTuning(SocketTuning::forProfile(a_profile));
+    }
+}
+
+void ReactorServerChannel::onConnect(ConnectionCallback a_callback)
+{
+    connectCallback = std::move(a_callback);
+}
+
+void ReactorServerChannel::onReadable(ConnectionCallback a_callback)
+{
+    readableCallback = std::move(a_callback);
+}
+
+void ReactorServerChannel::onDisconnect(ConnectionCallback a_callback)
+{
+    disconnectCallback = std::move(a_callback);
+}
+
+void ReactorServerChannel::onBackpressure(BackpressureCallback a_callback)
+{
+    backpressureCallback = std::move(a_callback);
+}
+
+void ReactorServerChannel::setSendQueueLimits(size_t a_lowWatermark, size_t a_highWatermark)
+{
+    lowWatermark = std::min(a_lowWatermark, a_highWatermark);
+    highWatermark = a_highWatermark;
+}
+
+void ReactorServerChannel::setFraming(FramingType a_framing)
+{
+    /* Accepted connections inherit the listener's framing*/
+    listenSocket->setFraming(a_framing);
+}
+
+SocketResult ReactorServerChannel::start()
+{
+    /*
+     ! The listener is made non-blocking before it is registered:
+     * epoll reports EPOLLIN on a listening socket when at least one connection is queued,
+     * acceptPending() then accepts until accept() reports EAGAIN (returns nullptr).
+     * SOMAXCONN is used as backlog so connection storms aren't refused by a 5-entry queue.
+     */
+    SocketResult result = listenSocket->bind(ip, port);
+    if (result.ok())
+    {
+        result = listenSocket->setNonBlocking(true);
+    }
+    if (result.ok())
+    {
+        result = listenSocket->listen(SOMAXCONN);
+    }
+    if (!result.ok())
+    {
+        return result;
+    }
+    loop.add(listenSocket->getFD(), EPOLLIN, [this](uint32_t)
+             { acceptPending(); });
+    started = true;
+    return result;
+}
+
+void ReactorServerChannel::acceptPending()
+{
+    while (true)
+    {
+        errno = 0;
+        Socket *client = listenSocket->accept();
+        if (client == nullptr)
+        {
+            int error = errno;
+            if (error == EMFILE || error == ENFILE || error == ENOBUFS || error == ENOMEM)
+            {
+                /*
+                 ! Out of descriptors (or memory):
+                 * the connection stays in the backlog and the level-triggered EPOLLIN would report it
+                 * again at once, spinning the loop until a descriptor is freed. The listener is taken
+                 * out of the poll set instead and re-armed by a timer; pending clients just wait.
+                 */
+                loop.modify(listenSocket->getFD(), 0);
+                acceptRetryTimer = loop.addTimer(ACCEPT_RETRY_MS, [this]()
+                                                 {
+                                                     acceptRetryTimer = 0;
+                                                     loop.modify(listenSocket->getFD(), EPOLLIN);
+                                                     acceptPending(); });
+            }
+            break; /* Backlog drained, or paused as above*/
+        }
+
+        /*
+         * Accepted sockets inherit the listener's deadlines. On the loop thread a deadline would poll
+         * inside send/receive and stall every connection, readiness comes from epoll instead.
+         */
+        client->setTimeouts(SocketTimeouts());
+
+        int connectionId = client->getFD();
+        connections[connectionId] = client;
+
+        /*
+         ~ EPOLLRDHUP reports a peer shutdown even when it arrives together with the last data,
+         ~ so the readable callback still gets a chance to consume that data before the close.
+         */
+        loop.add(connectionId, EPOLLIN | EPOLLRDHUP, [this, connectionId](uint32_t a_events)
+                 { handleConnectionEvents(connectionId, a_events); });
+
+        if (connectCallback)
+        {
+            connectCallback(connectionId, *client);
+        }
+    }
+}
+
+void ReactorServerChannel::handleConnectionEvents(int a_connectionId, uint32_t a_events)
+{
+    auto entry = connections.find(a_connectionId);
+    if (entry == connections.end())
+    {
+        return;
+    }
+
+    /* Only armed while output is queued*/
+    if (a_events & EPOLLOUT)
+    {
+        flushQueue(a_connectionId);
+        entry = connections.find(a_connectionId);
+        if (entry == connections.end())
+        {
+            return;
+        }
+    }
+
+    if ((a_events & EPOLLIN) && readableCallback)
+    {
+        readableCallback(a_connectionId, *entry->second);
+
+        /*
+         * One read may have buffered several framed messages. epoll won't report them again
+         * (they are no longer in the kernel), so the callback is repeated until they're consumed.
+         */
+        while (true)
+        {
+            entry = connections.find(a_connectionId);
+            if (entry == connections.end() || !entry->second->hasPendingMessage())
+            {
+                break;
+            }
+            readableCallback(a_connectionId, *entry->second);
+        }
+
+        /* Replies sent from the callback leave now, not when a corked (or io_uring) socket would send them*/
+        entry = connections.find(a_connectionId);
+        if (entry != connections.end())
+        {
+            entry->second->flush();
+        }
+    }
+
+    /* The readable callback may have closed the connection itself*/
+    if (connections.find(a_connectionId) == connections.end())
+    {
+        return;
+    }
+
+    if (a_events & (EPOLLHUP | EPOLLERR))
+    {
+        close(a_connectionId);
+    }
+    else if (a_events & EPOLLRDHUP)
+    {
+        /*
+         * The peer finished sending, but its last messages may still be unread in the kernel.
+         * The connection is closed only once nothing is left (peek returns 0 = end of stream),
+         * otherwise the level-triggered EPOLLIN brings us back here after the next read.
+         */
+        char probe;
+        if (::recv(a_connectionId, &probe, 1, MSG_PEEK | MSG_DONTWAIT) <= 0)
+        {
+            close(a_connectionId);
+        }
+    }
+}
+
+SocketResult ReactorServerChannel::send(int a_connectionId, const std::string &message)
+{
+    MessageSegment segment = {message.data(), message.size()};
+    return send(a_connectionId, &segment, 1);
+}
+
+SocketResult ReactorServerChannel::send(int a_connectionId, const MessageSegment *a_segments, size_t a_count)
+{
+    /*
+     ! Connections are non-blocking, a full socket buffer never stalls the loop:
+     * OK is returned once the message is written or queued (bytes = message length). Behind queued
+     * output a message is queued too, so the stream keeps its order. A send that blocks part way is
+     * queued from where it stopped and EPOLLOUT is armed to finish it.
+     * A congested connection refuses the message: WOULD_BLOCK with errorNumber ENOBUFS.
+     */
+    auto entry = connections.find(a_connectionId);
+    if (entry == connections.end())
+    {
+        return SocketResult::fromErrno(ENOTCONN);
+    }
+    size_t messageLength = 0;
+    for (size_t i = 0; i < a_count; i++)
+    {
+        messageLength += a_segments[i].length;
+    }
+
+    auto queue = sendQueues.find(a_connectionId);
+    size_t sentBytes = 0;
+    if (queue == sendQueues.end())
+    {
+        /* A deadline set on the connection later (TIMEOUT) is handled like WOULD_BLOCK: the rest is queued*/
+        SocketResult result = entry->second->send(a_segments, a_count);
+        if (result.status != SocketStatus::WOULD_BLOCK && result.status != SocketStatus::TIMEOUT)
+        {
+            return result;
+        }
+        sentBytes = result.bytes;
+        queue = sendQueues.emplace(a_connectionId, SendQueue(lowWatermark, highWatermark)).first;
+        loop.modify(a_connectionId, EPOLLIN | EPOLLRDHUP | EPOLLOUT);
+    }
+    if (!queue->second.push(a_segments, a_count, sentBytes))
+    {
+        return SocketResult(SocketStatus::WOULD_BLOCK, 0, ENOBUFS);
+    }
+    if (queue->second.isCongested() && backpressureCallback)
+    {
+        backpressureCallback(a_connectionId, true); /* This message was the one that reached the high watermark*/
+    }
+    return SocketResult::success(messageLength);
+}
+
+void ReactorServerChannel::flushQueue(int a_connectionId)
+{
+    auto queue = sendQueues.find(a_connectionId);
+    auto entry = connections.find(a_connectionId);
+    if (queue == sendQueues.end() || entry == connections.end())
+    {
+        return;
+    }
+    bool wasCongested = queue->second.isCongested();
+    SocketResult result = queue->second.flush(*entry->second);
+    if (result.status != SocketStatus::OK && result.status != SocketStatus::WOULD_BLOCK && result.status != SocketStatus::TIMEOUT)
+    {
+        close(a_connectionId); /* Broken connection, its output can't be delivered*/
+        return;
+    }
+    bool relieved = wasCongested && !queue->second.isCongested();
+    if (result.ok())
+    {
+        sendQueues.erase(queue);
+        loop.modify(a_connectionId, EPOLLIN | EPOLLRDHUP);
+    }
+    /* Last: the producer may send (or close) from the callback*/
+    if (relieved && backpressureCallback)
+    {
+        backpressureCallback(a_connectionId, false);
+    }
+}
+
+void ReactorServerChannel::broadcast(const std::string &message)
+{
+    /*
+     * Through send(), so a slow connection queues (or refuses) its copy instead of losing part of it.
+     * The ids are copied first: a failed send or the backpressure callback may close() connections
+     * while the loop runs, a closed id is then just skipped (ENOTCONN).
+     */
+    std::vector<int> ids;
+    ids.reserve(connections.size());
+    for (auto &connection : connections)
+    {
+        ids.push_back(connection.first);
+    }
+    MessageSegment segment = {message.data(), message.size()};
+    for (int id : ids)
+    {
+        send(id, &segment, 1);
+    }
+}
+
+size_t ReactorServerChannel::queuedBytes(int a_connectionId) const
+{
+    auto queue = sendQueues.find(a_connectionId);
+    return (queue != sendQueues.end()) ? queue->second.bytes() : 0;
+}
+
+bool ReactorServerChannel::isCongested(int a_connectionId) const
+{
+    auto queue = sendQueues.find(a_connectionId);
+    return queue != sendQueues.end() && queue->second.isCongested();
+}
+
+void ReactorServerChannel::close(int a_connectionId)
+{
+    auto entry = connections.find(a_connectionId);
+    if (entry == connections.end())
+    {
+        return;
+    }
+    Socket *client = entry->second;
+    connections.erase(entry);
+    sendQueues.erase(a_connectionId);
+
+    /* Deregister before shutdown() closes the descriptor, the id may be reused by the next accept*/
+    loop.remove(a_connectionId);
+    if (disconnectCallback)
+    {
+        disconnectCallback(a_connectionId, *client);
+    }
+    client->shutdown();
+    closedStats += client->stats();
+    delete client;
+}
+
+Socket *ReactorServerChannel::getConnection(int a_connectionId) const
+{
+    auto entry = connections.find(a_connectionId);
+    return (entry != connections.end()) ? entry->second : nullptr;
+}
+
+std::string ReactorServerChannel::getClientIP(int a_connectionId) const
+{
+    Socket *client = getConnection(a_connectionId);
+    if (client != nullptr)
+    {
+        return std::string(inet_ntoa(client->getAddress()->sin_addr));
+    }
+    else
+    {
+        return "No client connected";
+    }
+}
+
+size_t ReactorServerChannel::connectionCount() const
+{
+    return connections.size();
+}
+
+SocketCounters ReactorServerChannel::stats() const
+{
+    SocketCounters total = closedStats;
+    if (listenSocket != nullptr)
+    {
+        total += listenSocket->stats();
+    }
+    for (const auto &connection : connections)
+    {
+        total += connection.second->stats();
+    }
+    return total;
+}
+
+void ReactorServerChannel::stop()
+{
+    if (started)
+    {
+        while (!connections.empty())
+        {
+            close(connections.begin()->first);
+        }
+
+        if (acceptRetryTimer != 0)
+        {
+            loop.cancelTimer(acceptRetryTimer);
+            acceptRetryTimer = 0;
+        }
+        if (listenSocket != nullptr)
+        {
+            loop.remove(listenSocket->getFD());
+            listenSocket->shutdown();
+        }
+        else
+        {
+            /**
+             *! THROW
+             */
+            std::cerr << "Socket Deleted Before stopping the server ensure to call server.stop() before deletion" << std::endl;
+        }
+
+        started = false;
+    }
+}
+
+// Destructor for ReactorServerChannel
+ReactorServerChannel::~ReactorServerChannel()
+{
+    stop(); // Close every connection and the listener
+}
@@ -0,0 +1,58 @@
+#include "SendQueue.hpp"
+#include <cstring>
+
+SendQueue::SendQueue(size_t a_lowWatermark, size_t a_highWatermark)
+    : queuedBytes(0), lowWatermark(a_lowWatermark), highWatermark(a_highWatermark), congested(false) {}
+
+bool SendQueue::push(const MessageSegment *a_segments, size_t a_count, size_t a_sentBytes)
+{
+    /*
+     * A message is accepted while the queue is below the high watermark, so one message larger
+     * than the whole bound still goes through. The queue is bounded by highWatermark + one message.
+     */
+    if (congested)
+    {
+        return false;
+    }
+    size_t length = 0;
+    for (size_t i = 0; i < a_count; i++)
+    {
+        length += a_segments[i].length;
+    }
+    Message message = {BufferPool::Buffer(length), length, a_sentBytes};
+    char *cursor = message.data.data();
+    for (size_t i = 0; i < a_count; i++)
+    {
+        memcpy(cursor, a_segments[i].data, a_segments[i].length);
+        cursor += a_segments[i].length;
+    }
+    messages.push_back(std::move(message));
+    queuedBytes += length;
+    if (queuedBytes >= highWatermark)
+    {
+        congested = true;
+    }
+    return true;
+}
+
+SocketResult SendQueue::flush(Socket &a_socket)
+{
+    while (!messages.empty())
+    {
+        Message &front = messages.front();
+        MessageSegment segment = {front.data.data(), front.length};
+        SocketResult result = a_socket.sendRemaining(&segment, 1, front.sentBytes);
+        if (!result.ok())
+        {
+            front.sentBytes += result.bytes; /* WOULD_BLOCK: resumed from here on the next flush*/
+            return result;
+        }
+        queuedBytes -= front.length;
+        messages.pop_front();
+        if (congested && queuedBytes <= lowWatermark)
+        {
+            congested = false;
+        }
+    }
+    return SocketResult::success();
+}
@@ -1,24 +1,67 @@
 #include "ServerChannel.hpp"
 
-ServerChannel::ServerChannel(Socket *socket, int a_port, const std::string a_ip ) : Channel(socket), port(a_port), ip(a_ip), SocketToClient(nullptr) {}
+ServerChannel::ServerChannel(Socket *socket, int a_port, const std::string a_ip, TuningProfile a_profile) : Channel(socket), port(a_port), ip(a_ip), SocketToClient(nullptr)
+{
+    /* Set on the listener, the accepted socket inherits it*/
+    if (a_profile != TuningProfile::DEFAULT)
+    {
+        channelSocket->setTuning(SocketTuning::forProfile(a_profile));
+    }
+}
 
-void ServerChannel::start() 
+SocketResult ServerChannel::start() 
 {
-    channelSocket->bind(ip, port);
-    channelSocket->listen();
+    /* A non-blocking listener returns WOULD_BLOCK until a client arrives, start() is then called again*/
+    if (channelStatus == ChannelStatusType::CHANNEL_OFF)
+    {
+        SocketResult result = channelSocket->bind(ip, port);
+        if (!result.ok())
+        {
+            return result;
+        }
+        result = channelSocket->listen();
+        if (!result.ok())
+        {
+            return result;
+        }
+        channelStatus = ChannelStatusType::CHANNEL_ON;
+    }
+    if (SocketToClient != nullptr)
+    {
+        return SocketResult::success();
+    }
+
+    /* accept() returns nullptr for UDP, which has no connection to wait for*/
+    errno = 0;
     SocketToClient = channelSocket->accept();
-    channelStatus = ChannelStatusType::CHANNEL_ON;
+    if (SocketToClient == nullptr && errno != 0)
+    {
+        return SocketResult::fromErrno(errno);
+    }
+    return SocketResult::success();
+}
+
+SocketResult ServerChannel::send(const std::string &message) 
+{
+    if (SocketToClient != nullptr)
+    {
+        return SocketToClient->send(message);
+    }
+    else
+    {
+        return channelSocket->send(message);
+    }
 }
 
-void ServerChannel::send(const std::string &message) 
+SocketResult ServerChannel::send(const MessageSegment *a_segments, size_t a_count)
 {
     if (SocketToClient != nullptr)
     {
-        SocketToClient->send(message);
+        return SocketToClient->send(a_segments, a_count);
     }
     else
     {
-        channelSocket->send(message);
+        return channelSocket->send(a_segments, a_count);
     }
 }
 
@@ -34,6 +77,57 @@ std::string ServerChannel::receive()
     }
 }
 
+SocketResult ServerChannel::receive(char *a_buffer, size_t a_length)
+{
+    if (SocketToClient != nullptr)
+    {
+        return (SocketToClient->receive(a_buffer, a_length));
+    }
+    else
+    {
+        return (channelSocket->receive(a_buffer, a_length));
+    }
+}
+
+void ServerChannel::setFraming(FramingType a_framing)
+{
+    /* The listening socket passes its framing to the socket accept() returns*/
+    channelSocket->setFraming(a_framing);
+    if (SocketToClient != nullptr)
+    {
+        SocketToClient->setFraming(a_framing);
+    }
+}
+
+void ServerChannel::flush()
+{
+    if (SocketToClient != nullptr)
+    {
+        SocketToClient->flush();
+    }
+    else
+    {
+        channelSocket->flush();
+    }
+}
+
+Socket *ServerChannel::getSocket() const
+{
+    /* TCP: the accepted connection, UDP: the bound socket*/
+    return (SocketToClient != nullptr) ? SocketToClient : channelSocket;
+}
+
+SocketCounters ServerChannel::stats() const
+{
+    /* The listening/bound socket plus the accepted connection (if any)*/
+    SocketCounters total = channelSocket->stats();
+    if (SocketToClient != nullptr)
+    {
+        total += SocketToClient->stats();
+    }
+    return total;
+}
+
 std::string ServerChannel::getClientIP() const 
 {
     /*
@@ -0,0 +1,105 @@
+#include "ShardedServerChannel.hpp"
+
+ShardedServerChannel::ShardedServerChannel(int a_port, size_t a_workerCount, const std::string a_ip)
+    : port(a_port), ip(a_ip), workerCount(a_workerCount > 0 ? a_workerCount : 1), started(false) {}
+
+SocketResult ShardedServerChannel::start(WorkerSetup a_setup)
+{
+    if (started)
+    {
+        return SocketResult::success();
+    }
+
+    /*
+     ! 1 - Creating the shards on the calling thread:
+     * Every listener gets SO_REUSEPORT before ReactorServerChannel::start() binds it, so all of them
+     * are bound and listening when start() returns and no early connection can be refused.
+     * If one shard fails (e.g. the port is taken) the ones already started are closed again.
+     */
+    workers.resize(workerCount);
+    SocketResult result = SocketResult::success();
+    for (size_t i = 0; i < workerCount && result.ok(); i++)
+    {
+        Worker &worker = workers[i];
+        worker.listenSocket.reset(new TCPSocket());
+        worker.listenSocket->setReuseAddress(true);
+        result = worker.listenSocket->setReusePort(true);
+        worker.loop.reset(new EventLoop());
+        worker.channel.reset(new ReactorServerChannel(worker.listenSocket.get(), *worker.loop, port, ip));
+        if (a_setup)
+        {
+            a_setup(i, *worker.loop, *worker.channel);
+        }
+        if (result.ok())
+        {
+            result = worker.channel->start();
+        }
+    }
+    if (!result.ok())
+    {
+        for (Worker &worker : workers)
+        {
+            if (worker.channel)
+            {
+                worker.channel->stop();
+            }
+        }
+        workers.clear();
+        return result;
+    }
+
+    /*
+     ! 2 - Running the loops:
+     * From here on each loop (and the channel registered with it) is only touched by its own thread.
+     */
+    for (Worker &worker : workers)
+    {
+        EventLoop *loop = worker.loop.get();
+        worker.thread = std::thread([loop]()
+                                    { loop->run(); });
+    }
+    started = true;
+    return result;
+}
+
+void ShardedServerChannel::stop()
+{
+    if (started)
+    {
+        /* EventLoop::stop() is thread-safe (eventfd wakeup), the channels are closed once the threads are gone*/
+        for (Worker &worker : workers)
+        {
+            worker.loop->stop();
+        }
+        for (Worker &worker : workers)
+        {
+            if (worker.thread.joinable())
+            {
+                worker.thread.join();
+            }
+        }
+        for (Worker &worker : workers)
+        {
+            worker.channel->stop();
+            stoppedStats += worker.channel->stats();
+        }
+        workers.clear();
+        started = false;
+    }
+}
+
+size_t ShardedServerChannel::getWorkerCount() const
+{
+    return workerCount;
+}
+
+SocketCounters ShardedServerChannel::stats() const
+{
+    return stoppedStats;
+}
+
+// Destructor for ShardedServerChannel
+ShardedServerChannel::~ShardedServerChannel()
+{
+    stop(); // Stop the worker loops and close every connection
+}
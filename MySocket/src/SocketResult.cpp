@@ -0,0 +1,116 @@
+#include "SocketResult.hpp"
+#include <cerrno>
+#include <cstring>
+#include <poll.h> // For poll
+#include <sched.h> // For sched_yield
+
+SocketResult SocketResult::fromErrno(int a_errorNumber, size_t a_bytes)
+{
+    switch (a_errorNumber)
+    {
+    case EAGAIN:
+#if EWOULDBLOCK != EAGAIN
+    case EWOULDBLOCK:
+#endif
+    case EINPROGRESS:
+        return SocketResult(SocketStatus::WOULD_BLOCK, a_bytes, a_errorNumber);
+    case ETIMEDOUT:
+        return SocketResult(SocketStatus::TIMEOUT, a_bytes, a_errorNumber);
+    case EPIPE:
+    case ECONNRESET:
+    case ENOTCONN:
+        return SocketResult(SocketStatus::PEER_CLOSED, a_bytes, a_errorNumber);
+    default:
+        return SocketResult(SocketStatus::ERROR, a_bytes, a_errorNumber);
+    }
+}
+
+const char *SocketResult::describe() const
+{
+    switch (status)
+    {
+    case SocketStatus::OK:
+        return "OK";
+    case SocketStatus::WOULD_BLOCK:
+        return "Operation would block";
+    case SocketStatus::TIMEOUT:
+        return "Timed out";
+    case SocketStatus::PEER_CLOSED:
+        return "Connection closed by peer";
+    default:
+        return strerror(errorNumber);
+    }
+}
+
+Deadline::Deadline(int a_timeoutMs) : infinite(a_timeoutMs < 0)
+{
+    if (!infinite)
+    {
+        expiry = std::chrono::steady_clock::now() + std::chrono::milliseconds(a_timeoutMs);
+    }
+}
+
+bool Deadline::isInfinite() const
+{
+    return infinite;
+}
+
+int Deadline::remainingMs() const
+{
+    if (infinite)
+    {
+        return -1;
+    }
+    /* Rounded up: a truncated 0.9 ms would poll(0) and report TIMEOUT before the expiry*/
+    auto left = std::chrono::ceil<std::chrono::milliseconds>(expiry - std::chrono::steady_clock::now()).count();
+    return left > 0 ? (int)left : 0;
+}
+
+SocketResult Deadline::waitUntilReady(int a_fd, short a_events) const
+{
+    /*
+     ! poll with the time left:
+     * POLLERR/POLLHUP are always reported, the following system call then returns the actual error.
+     */
+    while (true)
+    {
+        struct pollfd waitFor = {a_fd, a_events, 0};
+        int ready = ::poll(&waitFor, 1, remainingMs());
+        if (ready > 0)
+        {
+            return SocketResult::success();
+        }
+        if (ready == 0)
+        {
+            return SocketResult(SocketStatus::TIMEOUT, 0, ETIMEDOUT);
+        }
+        if (errno != EINTR)
+        {
+            return SocketResult::fromErrno(errno);
+        }
+    }
+}
+
+SpinBudget::SpinBudget(int a_budgetUs) : spinning(a_budgetUs > 0)
+{
+    if (spinning)
+    {
+        expiry = std::chrono::steady_clock::now() + std::chrono::microseconds(a_budgetUs);
+    }
+}
+
+bool SpinBudget::keepSpinning()
+{
+    if (!spinning || std::chrono::steady_clock::now() >= expiry)
+    {
+        spinning = false;
+        return false;
+    }
+    /*
+     * sched_yield rather than a CPU pause: when the peer (e.g. the thread producing the reply) shares
+     * this core, a pure spin would keep it from running until the budget is gone. With the core to
+     * itself the call returns at once and costs about as much as the recv retry.
+     */
+    sched_yield();
+    return true;
+}
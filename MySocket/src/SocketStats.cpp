@@ -0,0 +1,162 @@
+#include "SocketStats.hpp"
+#include <mutex>
+#include <vector>
+
+SocketCounters &SocketCounters::operator+=(const SocketCounters &a_other)
+{
+    bytesIn += a_other.bytesIn;
+    bytesOut += a_other.bytesOut;
+    messagesIn += a_other.messagesIn;
+    messagesOut += a_other.messagesOut;
+    syscalls += a_other.syscalls;
+    shortReads += a_other.shortReads;
+    shortWrites += a_other.shortWrites;
+    wouldBlocks += a_other.wouldBlocks;
+    errors += a_other.errors;
+    truncatedDatagrams += a_other.truncatedDatagrams;
+    spinReceives += a_other.spinReceives;
+    spinFallbacks += a_other.spinFallbacks;
+    return *this;
+}
+
+SocketCounters &SocketCounters::operator-=(const SocketCounters &a_other)
+{
+    bytesIn -= a_other.bytesIn;
+    bytesOut -= a_other.bytesOut;
+    messagesIn -= a_other.messagesIn;
+    messagesOut -= a_other.messagesOut;
+    syscalls -= a_other.syscalls;
+    shortReads -= a_other.shortReads;
+    shortWrites -= a_other.shortWrites;
+    wouldBlocks -= a_other.wouldBlocks;
+    errors -= a_other.errors;
+    truncatedDatagrams -= a_other.truncatedDatagrams;
+    spinReceives -= a_other.spinReceives;
+    spinFallbacks -= a_other.spinFallbacks;
+    return *this;
+}
+
+/*
+ * Thread indexes: taken at a thread's first count and handed back at its exit, under a mutex,
+ * so the next owner of a slot sees everything the previous one stored.
+ */
+static std::mutex threadIndexMutex;
+static std::vector<size_t> freeThreadIndexes;
+static size_t nextThreadIndex = 0;
+
+namespace
+{
+    struct ThreadIndexGuard
+    {
+        size_t *index;
+
+        ~ThreadIndexGuard()
+        {
+            std::lock_guard<std::mutex> lock(threadIndexMutex);
+            freeThreadIndexes.push_back(*index);
+            *index = SocketStats::MAX_OWNED_SLOTS; /* Counts made by later thread_local destructors go to the shared slot*/
+        }
+    };
+}
+
+size_t SocketStats::assignThreadIndex()
+{
+    {
+        std::lock_guard<std::mutex> lock(threadIndexMutex);
+        if (!freeThreadIndexes.empty())
+        {
+            threadIndex = freeThreadIndexes.back();
+            freeThreadIndexes.pop_back();
+        }
+        else
+        {
+            threadIndex = (nextThreadIndex < MAX_OWNED_SLOTS) ? nextThreadIndex++ : MAX_OWNED_SLOTS;
+        }
+    }
+    if (threadIndex < MAX_OWNED_SLOTS)
+    {
+        thread_local ThreadIndexGuard guard = {&threadIndex};
+        (void)guard;
+    }
+    return threadIndex;
+}
+
+SocketStats::Slot *SocketStats::claimSlot(size_t a_index)
+{
+    /* Zeroed, and published with release so snapshot() on another thread never sees it half made*/
+    Slot *slot = new Slot();
+    owned[a_index].store(slot, std::memory_order_release);
+    return slot;
+}
+
+SocketStats::SocketStats()
+{
+    for (std::atomic<Slot *> &slot : owned)
+    {
+        slot.store(nullptr, std::memory_order_relaxed);
+    }
+    reset();
+}
+
+SocketCounters SocketStats::snapshot() const
+{
+    uint64_t totals[COUNTER_COUNT] = {};
+    for (size_t i = 0; i < COUNTER_COUNT; i++)
+    {
+        totals[i] = shared.values[i].load(std::memory_order_relaxed);
+    }
+    for (const std::atomic<Slot *> &owner : owned)
+    {
+        const Slot *slot = owner.load(std::memory_order_acquire);
+        if (slot == nullptr)
+        {
+            continue;
+        }
+        for (size_t i = 0; i < COUNTER_COUNT; i++)
+        {
+            totals[i] += slot->values[i].load(std::memory_order_relaxed);
+        }
+    }
+    SocketCounters counters;
+    counters.bytesIn = totals[BYTES_IN];
+    counters.bytesOut = totals[BYTES_OUT];
+    counters.messagesIn = totals[MESSAGES_IN];
+    counters.messagesOut = totals[MESSAGES_OUT];
+    counters.syscalls = totals[SYSCALLS];
+    counters.shortReads = totals[SHORT_READS];
+    counters.shortWrites = totals[SHORT_WRITES];
+    counters.wouldBlocks = totals[WOULD_BLOCKS];
+    counters.errors = totals[ERRORS];
+    counters.truncatedDatagrams = totals[TRUNCATED_DATAGRAMS];
+    counters.spinReceives = totals[SPIN_RECEIVES];
+    counters.spinFallbacks = totals[SPIN_FALLBACKS];
+    return counters;
+}
+
+void SocketStats::reset()
+{
+    for (std::atomic<uint64_t> &value : shared.values)
+    {
+        value.store(0, std::memory_order_relaxed);
+    }
+    for (std::atomic<Slot *> &owner : owned)
+    {
+        Slot *slot = owner.load(std::memory_order_acquire);
+        if (slot == nullptr)
+        {
+            continue;
+        }
+        for (std::atomic<uint64_t> &value : slot->values)
+        {
+            value.store(0, std::memory_order_relaxed);
+        }
+    }
+}
+
+SocketStats::~SocketStats()
+{
+    for (std::atomic<Slot *> &owner : owned)
+    {
+        delete owner.load(std::memory_order_relaxed);
+    }
+}
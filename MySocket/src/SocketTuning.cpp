@@ -0,0 +1,109 @@
+#include "SocketTuning.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <netinet/in.h>
+#include <netinet/ip.h>  // For IPTOS_LOWDELAY and IPTOS_THROUGHPUT
+#include <netinet/tcp.h> // For TCP_NODELAY and TCP_CORK
+#include <sys/socket.h>
+
+SocketTuning SocketTuning::forProfile(TuningProfile a_profile)
+{
+    SocketTuning tuning;
+    switch (a_profile)
+    {
+    case TuningProfile::LOW_LATENCY:
+        tuning.noDelay = true;
+        tuning.busyPollUs = 50;
+        tuning.priority = 6;
+        tuning.typeOfService = IPTOS_LOWDELAY;
+        break;
+    case TuningProfile::BULK_THROUGHPUT:
+        tuning.sendBufferBytes = 4 * 1024 * 1024;
+        tuning.receiveBufferBytes = 4 * 1024 * 1024;
+        tuning.cork = true;
+        tuning.typeOfService = IPTOS_THROUGHPUT;
+        break;
+    case TuningProfile::LOW_MEMORY:
+        tuning.sendBufferBytes = 16 * 1024;
+        tuning.receiveBufferBytes = 16 * 1024;
+        break;
+    case TuningProfile::DEFAULT:
+        break;
+    }
+    return tuning;
+}
+
+bool SocketTuning::isDefault() const
+{
+    return sendBufferBytes <= 0 && receiveBufferBytes <= 0 && !noDelay && !cork && busyPollUs <= 0 && priority < 0 && typeOfService < 0;
+}
+
+static int setOption(int a_fd, int a_level, int a_name, int a_value)
+{
+    return setsockopt(a_fd, a_level, a_name, &a_value, sizeof(a_value)) < 0 ? errno : 0;
+}
+
+static int setBufferSize(int a_fd, int a_forceName, int a_name, int a_bytes)
+{
+    /* The FORCE variant ignores [rw]mem_max but needs CAP_NET_ADMIN, the plain one is clamped*/
+    int error = setOption(a_fd, SOL_SOCKET, a_forceName, a_bytes);
+    return (error == EPERM) ? setOption(a_fd, SOL_SOCKET, a_name, a_bytes) : error;
+}
+
+SocketResult SocketTuning::apply(int a_fd, bool a_stream, const SocketTuning &a_previous) const
+{
+    if (a_fd < 0)
+    {
+        return SocketResult::fromErrno(EBADF);
+    }
+    int firstError = 0;
+    auto check = [&firstError](int a_error, bool a_optional)
+    {
+        if (a_error != 0 && firstError == 0 && !(a_optional && a_error == EPERM))
+        {
+            firstError = a_error;
+        }
+    };
+
+    if (sendBufferBytes > 0)
+    {
+        check(setBufferSize(a_fd, SO_SNDBUFFORCE, SO_SNDBUF, sendBufferBytes), false);
+    }
+    if (receiveBufferBytes > 0)
+    {
+        check(setBufferSize(a_fd, SO_RCVBUFFORCE, SO_RCVBUF, receiveBufferBytes), false);
+    }
+
+    /*
+     * Options the previous tuning turned on and this one leaves off are cleared, otherwise a switch
+     * from BULK_THROUGHPUT to LOW_LATENCY would keep the socket corked. Clearing TCP_CORK also
+     * sends the partial segment it held back.
+     */
+    if (a_stream && (noDelay || a_previous.noDelay))
+    {
+        check(setOption(a_fd, IPPROTO_TCP, TCP_NODELAY, noDelay ? 1 : 0), false);
+    }
+    if (a_stream && (cork || a_previous.cork))
+    {
+        check(setOption(a_fd, IPPROTO_TCP, TCP_CORK, cork ? 1 : 0), false);
+    }
+    /* SO_BUSY_POLL can only be raised with CAP_NET_ADMIN: EPERM is reported, the profile would silently not spin*/
+    if (busyPollUs > 0 || a_previous.busyPollUs > 0)
+    {
+        check(setOption(a_fd, SOL_SOCKET, SO_BUSY_POLL, std::max(busyPollUs, 0)), false);
+    }
+    if (priority >= 0 || a_previous.priority >= 0)
+    {
+        check(setOption(a_fd, SOL_SOCKET, SO_PRIORITY, std::max(priority, 0)), true);
+    }
+    if (typeOfService >= 0 || a_previous.typeOfService >= 0)
+    {
+        check(setOption(a_fd, IPPROTO_IP, IP_TOS, std::max(typeOfService, 0)), false);
+    }
+    return firstError == 0 ? SocketResult::success() : SocketResult::fromErrno(firstError);
+}
+
+SocketResult SocketTuning::apply(int a_fd, bool a_stream) const
+{
+    return apply(a_fd, a_stream, SocketTuning());
+}
@@ -1,30 +1,156 @@
 #include "TCPSocket.hpp"
 
-TCPSocket::TCPSocket()
+TCPSocket::TCPSocket(IOBackendType a_backend)
 {
     /* socket(AF_INET, SOCK_STREAM, 0) creates a TCP socket */
     sock = socket(AF_INET, SOCK_STREAM, 0);
     if (sock < 0)
     {
-        std::cerr << "Socket creation failed!" << std::endl;
+        /* Every later operation reports EBADF (see socketClosed())*/
+        sock = -1;
     }
+    initBackend(a_backend);
 }
 
-TCPSocket::TCPSocket(int a_clientSock, struct sockaddr_in a_address) : sock(a_clientSock), address(a_address)
+TCPSocket::TCPSocket(int a_clientSock, struct sockaddr_in a_address, bool a_nonBlocking, IOBackendType a_backend) : sock(a_clientSock), address(a_address), nonBlocking(a_nonBlocking)
 {
     /**
      * ! The explicit keyword:
      * * Prevents unintended implicit conversions, making code clearer and avoiding bugs.
      * * Requires explicit calls to constructors and conversion operators, enhancing control over object creation and conversion.
      */
+    initBackend(a_backend);
+}
+
+void TCPSocket::initBackend(IOBackendType a_backend)
+{
+    /*
+     * The IO_URING backend attaches the socket to the ring of the constructing thread.
+     * If io_uring isn't available (old kernel, seccomp...) the socket stays on blocking calls.
+     */
+    backend = a_backend;
+    sendRequest.owner = this;
+    if (backend == IOBackendType::IO_URING)
+    {
+        ring = &IOUring::threadRing();
+        if (!ring->isReady())
+        {
+            ring = nullptr;
+            backend = IOBackendType::BLOCKING;
+        }
+    }
 }
 
 const struct sockaddr_in* TCPSocket::getAddress() const
 {
     return &address;
 }
-void TCPSocket::connect(const std::string &a_ip, int a_port) 
+
+int TCPSocket::getFD() const
+{
+    return sock;
+}
+
+SocketResult TCPSocket::setNonBlocking(bool a_nonBlocking)
+{
+    /*
+     ! O_NONBLOCK:
+     * In non-blocking mode accept/recv/send return -1 with errno EAGAIN (or EWOULDBLOCK)
+     * instead of putting the thread to sleep, which is what an epoll event loop needs.
+     * Sockets returned by accept() inherit the mode of the listening socket.
+     */
+    int flags = fcntl(sock, F_GETFL, 0);
+    if (flags < 0)
+    {
+        return SocketResult::fromErrno(errno);
+    }
+    flags = a_nonBlocking ? (flags | O_NONBLOCK) : (flags & ~O_NONBLOCK);
+    if (fcntl(sock, F_SETFL, flags) < 0)
+    {
+        return SocketResult::fromErrno(errno);
+    }
+    nonBlocking = a_nonBlocking;
+    return SocketResult::success();
+}
+
+void TCPSocket::setTimeouts(const SocketTimeouts &a_timeouts)
+{
+    /* Deadlines are enforced with poll + MSG_DONTWAIT, so the descriptor keeps its blocking mode*/
+    timeouts = a_timeouts;
+}
+
+SocketTimeouts TCPSocket::getTimeouts() const
+{
+    return timeouts;
+}
+
+SocketResult TCPSocket::setTuning(const SocketTuning &a_tuning)
 {
+    /*
+     ! Call before connect()/listen():
+     * the receive buffer size decides the window scale offered in the SYN, a larger buffer set
+     * afterwards can't be fully used. A listener passes its buffer sizes on to accepted sockets.
+     */
+    SocketTuning previous = tuning;
+    tuning = a_tuning;
+    if (sock < 0)
+    {
+        return socketClosed();
+    }
+    return tuning.apply(sock, true, previous);
+}
+
+SocketTuning TCPSocket::getTuning() const
+{
+    return tuning;
+}
+
+SocketResult TCPSocket::setBusyPoll(int a_spinBudgetUs)
+{
+    /*
+     ! Busy-poll receive:
+     * A blocking receive first retries non-blocking recv calls for up to a_spinBudgetUs. A reply that
+     * arrives within the budget is picked up without the sleep and wakeup of a blocking recv (a
+     * context switch, often a C-state exit: tens of microseconds). Then it blocks (or waits for the
+     * receive deadline) as before. SO_BUSY_POLL gets the same budget, so with a NAPI driver the
+     * kernel polls the device queue during each call instead of waiting for the interrupt; it is
+     * skipped without CAP_NET_ADMIN above net.core.busy_read, the user-space spin still applies.
+     *
+     * Spinning keeps the receiving thread runnable (it yields between retries, see SpinBudget), a
+     * core stays busy for the budget: meant for command/ack paths. Non-blocking
+     * sockets and the io_uring backend don't spin.
+     */
+    if (sock < 0)
+    {
+        return socketClosed();
+    }
+    busyPollBudgetUs = std::max(a_spinBudgetUs, 0);
+    int kernelBudget = (busyPollBudgetUs > 0) ? busyPollBudgetUs : std::max(tuning.busyPollUs, 0); /* Off: back to the profile's value*/
+    if (setsockopt(sock, SOL_SOCKET, SO_BUSY_POLL, &kernelBudget, sizeof(kernelBudget)) < 0 && errno != EPERM)
+    {
+        return SocketResult::fromErrno(errno);
+    }
+    return SocketResult::success();
+}
+
+SocketResult TCPSocket::socketClosed() const
+{
+    return SocketResult(SocketStatus::ERROR, 0, EBADF);
+}
+
+bool TCPSocket::fitsFrame(size_t a_messageLength) const
+{
+    /* The 4-byte prefix can't carry more, and the peer's decoder would reject it as corruption*/
+    return framing != FramingType::LENGTH_PREFIXED || a_messageLength <= decoder.getMaxFrameSize();
+}
+
+SocketResult TCPSocket::connect(const std::string &a_ip, int a_port) 
+{
+    if (sock < 0)
+    {
+        return socketClosed();
+    }
+
     /*
      ! 1- Defining the Server Address:
      * sockaddr_in is a structure that specifies address details:
@@ -48,10 +174,7 @@ void TCPSocket::connect(const std::string &a_ip, int a_port)
      */
     if (inet_pton(AF_INET, a_ip.c_str(), &address.sin_addr) <= 0)
     {
-        /**
-         *! THROW
-         */
-        std::cerr << "Invalid address!" << std::endl;
+        return SocketResult(SocketStatus::ERROR, 0, EINVAL);
     }
 
     /*
@@ -62,19 +185,55 @@ void TCPSocket::connect(const std::string &a_ip, int a_port)
     *  sizeof(address): Specifies the size of the address structure.
     *
     *
-    *  If connect fails (returns -1), it indicates the server is unreachable or the connection is denied. An error message is printed, and the program exits.
+    *  If connect fails (returns -1), it indicates the server is unreachable or the connection is denied.
+    *
+    ~ With a connect deadline the socket is switched to O_NONBLOCK for the attempt: connect returns
+    ~ EINPROGRESS, poll waits for POLLOUT at most until the deadline, and SO_ERROR holds the outcome
+    ~ (0 or e.g. ECONNREFUSED). A non-blocking socket without a deadline returns WOULD_BLOCK,
+    ~ the connection completes in the background and EPOLLOUT reports it.
     */
+    Deadline deadline(timeouts.connectMs);
+    if (deadline.isInfinite() && !nonBlocking)
+    {
+        if (::connect(sock, (struct sockaddr *)&address, sizeof(address)) < 0)
+        {
+            return SocketResult::fromErrno(errno);
+        }
+        return SocketResult::success();
+    }
 
+    if (!nonBlocking)
+    {
+        fcntl(sock, F_SETFL, fcntl(sock, F_GETFL, 0) | O_NONBLOCK);
+    }
+    SocketResult result = SocketResult::success();
     if (::connect(sock, (struct sockaddr *)&address, sizeof(address)) < 0)
     {
-        /**
-         *! THROW
-         */
-        std::cerr << "Connection failed!" << std::endl;
+        result = SocketResult::fromErrno(errno);
+        if (errno == EINPROGRESS && !deadline.isInfinite())
+        {
+            result = deadline.waitUntilReady(sock, POLLOUT);
+            if (result.ok())
+            {
+                int error = 0;
+                socklen_t length = sizeof(error);
+                getsockopt(sock, SOL_SOCKET, SO_ERROR, &error, &length);
+                result = (error == 0) ? SocketResult::success() : SocketResult::fromErrno(error);
+            }
+        }
     }
+    if (!nonBlocking)
+    {
+        fcntl(sock, F_SETFL, fcntl(sock, F_GETFL, 0) & ~O_NONBLOCK);
+    }
+    return result;
 }
-void TCPSocket::bind(const std::string &a_ip, int a_port) 
+SocketResult TCPSocket::bind(const std::string &a_ip, int a_port) 
 {
+    if (sock < 0)
+    {
+        return socketClosed();
+    }
 
     /*
      ! 1 - Binding the Socket to an IP Address and Port
@@ -98,34 +257,30 @@ void TCPSocket::bind(const std::string &a_ip, int a_port)
      *
      *
      * If bind fails (returns -1), it indicates that the port may already be in use,
-     * or the server lacks necessary permissions. An error message is printed, and the program exits.
+     * or the server lacks necessary permissions (EADDRINUSE / EACCES in the result).
      */
 
     if (::bind(sock, (struct sockaddr *)&address, sizeof(address)) < 0)
     {
-        /**
-         *! THROW
-         */
-        std::cerr << "Bind failed!" << std::endl;
+        return SocketResult::fromErrno(errno);
     }
+    return SocketResult::success();
 }
-void TCPSocket::listen(int backlog) 
+SocketResult TCPSocket::listen(int backlog) 
 {
     /*
      ! 3 - Putting the Server in a Listening State:
      * listen(sock, 3) puts the server socket into a listening state,
      *  allowing it to queue up to 3 incoming connections.
      *
-     * If listen fails (returns -1), the program exits with an error message.
+     * If listen fails (returns -1), the reason is returned.
      */
 
     if (::listen(sock, backlog) < 0)
     {
-        /**
-         *! THROW
-         */
-        std::cerr << "Listen failed!" << std::endl;
+        return SocketResult::fromErrno(errno);
     }
+    return SocketResult::success();
 }
 
 Socket *TCPSocket::accept() 
@@ -142,22 +297,50 @@ Socket *TCPSocket::accept()
      *  (socklen_t*)&addrlen : A pointer to the size of the client address structure.
      *
      * If accept returns -1, it indicates a failure to accept the connection, often due to client disconnection or a timeout.
+     *
+     ~ accept4 with SOCK_NONBLOCK lets a non-blocking listener hand out non-blocking connections
+     ~ without an extra fcntl call per client. A non-blocking listener with an empty queue returns
+     ~ nullptr silently (EAGAIN), which tells an accept loop that it has drained the backlog.
      */
     struct sockaddr_in client_address;
     int addrlen = sizeof(client_address);
-    int client_sock = ::accept(sock, (struct sockaddr *)&client_address, (socklen_t *)&addrlen);
+    int client_sock;
+    if (backend == IOBackendType::IO_URING)
+    {
+        /* The accept is submitted together with everything else queued on the thread ring*/
+        IOUring::Request request;
+        ring->prepareAccept(sock, (struct sockaddr *)&client_address, (socklen_t *)&addrlen, nonBlocking ? SOCK_NONBLOCK : 0, &request);
+        ring->waitFor(request);
+        client_sock = request.result;
+        if (client_sock < 0)
+        {
+            errno = -client_sock;
+        }
+    }
+    else
+    {
+        client_sock = ::accept4(sock, (struct sockaddr *)&client_address, (socklen_t *)&addrlen, nonBlocking ? SOCK_NONBLOCK : 0);
+    }
     if (client_sock < 0)
     {
-        /**
-         *! THROW
-         */
-        std::cerr << "Accept failed!" << std::endl;
+        /* errno tells an empty queue (EAGAIN) from a real failure*/
         return nullptr;
     }
-    return new TCPSocket(client_sock, client_address);
+    TCPSocket *client = new TCPSocket(client_sock, client_address, nonBlocking, backend);
+    client->setFraming(framing);
+    client->setTimeouts(timeouts);
+    if (!tuning.isDefault())
+    {
+        client->setTuning(tuning); /* Buffer sizes are inherited from the listener, the TCP options aren't all*/
+    }
+    if (busyPollBudgetUs > 0)
+    {
+        client->setBusyPoll(busyPollBudgetUs);
+    }
+    return client;
 }
 
-void TCPSocket::send(const std::string &message) 
+SocketResult TCPSocket::send(const std::string &message) 
 {
     /*
      * send(sock, message, strlen(message), 0) sends the message "Hello from client" to the server.
@@ -167,16 +350,651 @@ void TCPSocket::send(const std::string &message)
      * strlen(message): the length of the data.
      * 0: no special flags are used.
      * */
-    if (sock >= 0)
+    MessageSegment segment = {message.data(), message.size()};
+    return send(&segment, 1);
+}
+
+SocketResult TCPSocket::send(const MessageSegment *a_segments, size_t a_count)
+{
+    if (sock < 0)
+    {
+        return socketClosed();
+    }
+    if (backend != IOBackendType::IO_URING)
+    {
+        return sendMessage(a_segments, a_count, 0);
+    }
+
+    size_t messageLength = 0;
+    for (size_t i = 0; i < a_count; i++)
+    {
+        messageLength += a_segments[i].length;
+    }
+    if (!fitsFrame(messageLength))
+    {
+        statistics.add(SocketStats::ERRORS);
+        return SocketResult::fromErrno(EMSGSIZE);
+    }
+
+    /* A failure of an earlier queued send is reported here, the stream can't be trusted after it*/
+    if (uringSendError != 0)
+    {
+        return SocketResult::fromErrno(uringSendError);
+    }
+    /* Queue only: the send is submitted with the next batch (receive, flush, shutdown or a full batch)*/
+    if (framing == FramingType::LENGTH_PREFIXED)
+    {
+        char header[FrameDecoder::HEADER_SIZE];
+        FrameDecoder::encodeHeader((uint32_t)messageLength, header);
+        pendingOutput.append(header, sizeof(header));
+    }
+    for (size_t i = 0; i < a_count; i++)
     {
-        ::send(sock, message.c_str(), message.size(), 0);
+        pendingOutput.append((const char *)a_segments[i].data, a_segments[i].length);
     }
+    if (!sendInFlight)
+    {
+        queueNextSend();
+    }
+    if (ring->pendingSubmissions() >= IOUring::SUBMIT_BATCH)
+    {
+        ring->submit();
+    }
+    statistics.add(SocketStats::MESSAGES_OUT);
+    statistics.add(SocketStats::BYTES_OUT, messageLength);
+    return SocketResult::success(messageLength);
+}
+
+SocketResult TCPSocket::sendRemaining(const MessageSegment *a_segments, size_t a_count, size_t a_sentBytes)
+{
+    /* io_uring sends are queued whole and never report a partial write, there is nothing to resume*/
+    if (a_sentBytes == 0)
+    {
+        return send(a_segments, a_count);
+    }
+    if (sock < 0)
+    {
+        return socketClosed();
+    }
+    return sendMessage(a_segments, a_count, a_sentBytes);
+}
+
+SocketResult TCPSocket::sendMessage(const MessageSegment *a_segments, size_t a_count, size_t a_skipBytes)
+{
+    size_t messageLength = 0;
+    for (size_t i = 0; i < a_count; i++)
+    {
+        messageLength += a_segments[i].length;
+    }
+    if (!fitsFrame(messageLength))
+    {
+        statistics.add(SocketStats::ERRORS);
+        return SocketResult::fromErrno(EMSGSIZE);
+    }
+    char header[FrameDecoder::HEADER_SIZE];
+    bool framed = (framing == FramingType::LENGTH_PREFIXED);
+    if (framed)
+    {
+        FrameDecoder::encodeHeader((uint32_t)messageLength, header);
+    }
+
+    /*
+     ! sendmsg (writev for sockets):
+     * The kernel gathers the iovec array in order, so the frame header and every segment
+     * leave in one system call without building a concatenated copy.
+     * Up to 16 segments use a stack array, longer lists fall back to a vector.
+     */
+    struct iovec localSegments[16];
+    std::vector<struct iovec> heapSegments;
+    size_t iovCount = a_count + (framed ? 1 : 0);
+    struct iovec *segments = localSegments;
+    if (iovCount > 16)
+    {
+        heapSegments.resize(iovCount);
+        segments = heapSegments.data();
+    }
+    size_t index = 0;
+    if (framed)
+    {
+        segments[index++] = {header, sizeof(header)};
+    }
+    for (size_t i = 0; i < a_count; i++)
+    {
+        segments[index++] = {(void *)a_segments[i].data, a_segments[i].length};
+    }
+
+    /* Resuming a partial send: the bytes already written (header included) are skipped*/
+    size_t first = 0;
+    while (a_skipBytes > 0 && first < iovCount)
+    {
+        size_t skip = std::min(a_skipBytes, segments[first].iov_len);
+        segments[first].iov_base = (char *)segments[first].iov_base + skip;
+        segments[first].iov_len -= skip;
+        a_skipBytes -= skip;
+        if (segments[first].iov_len == 0)
+        {
+            first++;
+        }
+    }
+    return sendSegments(segments + first, iovCount - first);
+}
+
+SocketResult TCPSocket::sendSegments(struct iovec *a_segments, size_t a_count)
+{
+    /*
+     ! Partial writes and the send deadline:
+     * sendmsg may take only part of the data when the socket buffer is full. The iovecs are advanced
+     * past what was written and the rest is sent once poll reports POLLOUT, until the deadline.
+     * A non-blocking socket without a deadline returns WOULD_BLOCK with bytes = what was written,
+     * the caller resumes from there. MSG_NOSIGNAL turns a broken connection into EPIPE (PEER_CLOSED)
+     * instead of a SIGPIPE that would kill the process.
+     */
+    Deadline deadline(timeouts.sendMs);
+    int flags = MSG_NOSIGNAL | (deadline.isInfinite() ? 0 : MSG_DONTWAIT);
+    struct msghdr message;
+    memset(&message, 0, sizeof(message));
+    message.msg_iov = a_segments;
+    message.msg_iovlen = a_count;
+
+    size_t total = 0;
+    while (message.msg_iovlen > 0)
+    {
+        ssize_t sent = ::sendmsg(sock, &message, flags);
+        statistics.add(SocketStats::SYSCALLS);
+        if (sent < 0)
+        {
+            int error = errno;
+            if (error == EINTR)
+            {
+                continue;
+            }
+            statistics.add((error == EAGAIN || error == EWOULDBLOCK) ? SocketStats::WOULD_BLOCKS : SocketStats::ERRORS);
+            if ((error == EAGAIN || error == EWOULDBLOCK) && !deadline.isInfinite())
+            {
+                SocketResult ready = deadline.waitUntilReady(sock, POLLOUT);
+                if (!ready.ok())
+                {
+                    ready.bytes = total;
+                    return ready;
+                }
+                continue;
+            }
+            return SocketResult::fromErrno(error, total);
+        }
+        total += (size_t)sent;
+        statistics.add(SocketStats::BYTES_OUT, (uint64_t)sent);
+
+        /* Skip the fully written iovecs and trim the partially written one*/
+        size_t advance = (size_t)sent;
+        while (message.msg_iovlen > 0 && advance >= message.msg_iov->iov_len)
+        {
+            advance -= message.msg_iov->iov_len;
+            message.msg_iov++;
+            message.msg_iovlen--;
+        }
+        if (message.msg_iovlen > 0)
+        {
+            statistics.add(SocketStats::SHORT_WRITES);
+            message.msg_iov->iov_base = (char *)message.msg_iov->iov_base + advance;
+            message.msg_iov->iov_len -= advance;
+        }
+    }
+    statistics.add(SocketStats::MESSAGES_OUT);
+    return SocketResult::success(total);
+}
+
+SocketResult TCPSocket::setReuseAddress(bool a_enable)
+{
+    /* SO_REUSEADDR: a restarted server can bind while old connections are still in TIME_WAIT*/
+    int value = a_enable ? 1 : 0;
+    if (setsockopt(sock, SOL_SOCKET, SO_REUSEADDR, &value, sizeof(value)) < 0)
+    {
+        return SocketResult::fromErrno(errno);
+    }
+    return SocketResult::success();
+}
+
+SocketResult TCPSocket::setReusePort(bool a_enable)
+{
+    /*
+     ! SO_REUSEPORT (must be set before bind):
+     * Several sockets may bind and listen on the same port. The kernel hashes every incoming
+     * connection to one of the listeners, so each one has its own accept queue and no lock is shared.
+     */
+    int value = a_enable ? 1 : 0;
+    if (setsockopt(sock, SOL_SOCKET, SO_REUSEPORT, &value, sizeof(value)) < 0)
+    {
+        return SocketResult::fromErrno(errno);
+    }
+    return SocketResult::success();
+}
+
+SocketResult TCPSocket::enableFastOpen(int a_queueLength)
+{
+    /*
+     ! TCP_FASTOPEN (listening socket, before listen):
+     * Accepts data carried in the SYN of clients holding a Fast Open cookie, so a request arrives
+     * one round trip earlier. a_queueLength bounds the pending Fast Open requests.
+     * Needs bit 2 of net.ipv4.tcp_fastopen, otherwise connections fall back to the normal handshake.
+     */
+    if (setsockopt(sock, IPPROTO_TCP, TCP_FASTOPEN, &a_queueLength, sizeof(a_queueLength)) < 0)
+    {
+        return SocketResult::fromErrno(errno);
+    }
+    return SocketResult::success();
+}
+
+SocketResult TCPSocket::enableFastOpenConnect()
+{
+    /*
+     ! TCP_FASTOPEN_CONNECT (client socket, before connect):
+     * connect() returns at once without a handshake and the first send() goes out in the SYN.
+     * The first connection to a server only fetches the cookie, later ones skip the round trip.
+     * Needs bit 1 of net.ipv4.tcp_fastopen (the default).
+     */
+    int enable = 1;
+    if (setsockopt(sock, IPPROTO_TCP, TCP_FASTOPEN_CONNECT, &enable, sizeof(enable)) < 0)
+    {
+        return SocketResult::fromErrno(errno);
+    }
+    return SocketResult::success();
+}
+
+bool TCPSocket::isReusable() const
+{
+    /*
+     * Health check for an idle connection (see ConnectionPool): it must be open, have no
+     * pending socket error, no buffered input left over from its last user, and the peer must not
+     * have closed it. MSG_PEEK | MSG_DONTWAIT: EAGAIN = alive and idle, 0 = closed, data = unread reply.
+     */
+    if (sock < 0 || uringSendError != 0 || decoder.bufferedBytes() > 0)
+    {
+        return false;
+    }
+    int error = 0;
+    socklen_t length = sizeof(error);
+    if (getsockopt(sock, SOL_SOCKET, SO_ERROR, &error, &length) < 0 || error != 0)
+    {
+        return false;
+    }
+    char probe;
+    ssize_t peeked = ::recv(sock, &probe, 1, MSG_PEEK | MSG_DONTWAIT);
+    return peeked < 0 && (errno == EAGAIN || errno == EWOULDBLOCK);
+}
+
+bool TCPSocket::enableZeroCopy()
+{
+    /*
+     ! SO_ZEROCOPY (Linux 4.14+):
+     * Allows sendmsg(MSG_ZEROCOPY), where the kernel pins and transmits the caller's pages instead of
+     * copying them into socket buffers. It pays off for large payloads (roughly >10 KB, firmware blobs,
+     * bulk logs), small messages are cheaper to copy than to pin and notify.
+     * The io_uring backend keeps the regular copy path.
+     * Returns false when SO_ZEROCOPY is not available, sendZeroCopy() then copies.
+     */
+    int enable = 1;
+    if (backend == IOBackendType::IO_URING || setsockopt(sock, SOL_SOCKET, SO_ZEROCOPY, &enable, sizeof(enable)) < 0)
+    {
+        zeroCopy = false;
+        return false;
+    }
+    zeroCopy = true;
+    return true;
+}
+
+SocketResult TCPSocket::sendZeroCopy(const void *a_data, size_t a_length, ZeroCopyTracker::ReleaseCallback a_release, size_t a_sentBytes)
+{
+    /*
+     * Sends a_length bytes from a_data without copying them. The buffer must stay valid and unmodified
+     * until a_release is called, which happens from pollZeroCopyCompletions()/waitZeroCopyCompletions()
+     * (or shutdown()) once the kernel reported all of it as transmitted.
+     * Without SO_ZEROCOPY the data is sent with a regular copy and a_release runs immediately.
+     * The send deadline applies while waiting for socket buffer space.
+     *
+     * WOULD_BLOCK (non-blocking socket without a send deadline) and TIMEOUT report in bytes what was
+     * written, the frame header included, like sendRemaining(). The message is finished by calling
+     * again with the same data and a_sentBytes = bytes; a_release stays the one of the first call.
+     */
+    if (sock < 0 || !zeroCopy)
+    {
+        MessageSegment segment = {a_data, a_length};
+        SocketResult result = sendRemaining(&segment, 1, a_sentBytes);
+        if (a_release)
+        {
+            a_release();
+        }
+        return result;
+    }
+
+    if (!fitsFrame(a_length))
+    {
+        if (a_release)
+        {
+            a_release();
+        }
+        statistics.add(SocketStats::ERRORS);
+        return SocketResult::fromErrno(EMSGSIZE);
+    }
+
+    /*
+     * The frame header goes out in the same sendmsg as the payload, so a partial write never leaves
+     * the stream between the two. The kernel pins it like the payload, it lives in the tracker entry.
+     */
+    char *header = (a_sentBytes > 0) ? zeroCopyTracker.openPrefix() : nullptr;
+    if (header == nullptr)
+    {
+        header = zeroCopyTracker.open(std::move(a_release));
+    }
+    size_t headerLength = 0;
+    if (framing == FramingType::LENGTH_PREFIXED)
+    {
+        FrameDecoder::encodeHeader((uint32_t)a_length, header);
+        headerLength = FrameDecoder::HEADER_SIZE;
+    }
+    size_t total = headerLength + a_length;
+    size_t sentBytes = std::min(a_sentBytes, total);
+
+    Deadline deadline(timeouts.sendMs);
+    int flags = MSG_ZEROCOPY | MSG_NOSIGNAL | (deadline.isInfinite() ? 0 : MSG_DONTWAIT);
+    SocketResult result = SocketResult::success();
+    while (sentBytes < total)
+    {
+        struct iovec segments[2];
+        size_t count = 0;
+        if (sentBytes < headerLength)
+        {
+            segments[count++] = {header + sentBytes, headerLength - sentBytes};
+        }
+        size_t payloadSent = sentBytes - std::min(sentBytes, headerLength);
+        segments[count++] = {(char *)a_data + payloadSent, a_length - payloadSent};
+        struct msghdr message;
+        memset(&message, 0, sizeof(message));
+        message.msg_iov = segments;
+        message.msg_iovlen = count;
+
+        ssize_t sent = ::sendmsg(sock, &message, flags);
+        statistics.add(SocketStats::SYSCALLS);
+        if (sent < 0)
+        {
+            int error = errno;
+            if (error == EINTR)
+            {
+                continue;
+            }
+            bool bufferFull = (error == EAGAIN || error == EWOULDBLOCK);
+            if (!bufferFull && error != ENOBUFS)
+            {
+                statistics.add(SocketStats::ERRORS);
+                result = SocketResult::fromErrno(error);
+                break;
+            }
+            statistics.add(SocketStats::WOULD_BLOCKS);
+
+            /*
+             * ENOBUFS: too many unacknowledged zero-copy sends (optmem limit), retried once some
+             * completed. Reading the completions also clears the POLLERR they raise.
+             */
+            size_t completed = pollZeroCopyCompletions();
+            if (error == ENOBUFS && completed > 0)
+            {
+                continue;
+            }
+            if (error == ENOBUFS && !zeroCopyTracker.hasOutstandingCalls())
+            {
+                result = SocketResult::fromErrno(ENOBUFS); /* Nothing of ours to wait for*/
+                break;
+            }
+            if (nonBlocking && deadline.isInfinite())
+            {
+                result = SocketResult(SocketStatus::WOULD_BLOCK, 0, error);
+                break;
+            }
+            /* Socket buffer space (POLLOUT) or a completion (POLLERR, always reported)*/
+            result = deadline.waitUntilReady(sock, bufferFull ? POLLOUT : 0);
+            if (!result.ok())
+            {
+                break;
+            }
+            continue;
+        }
+        zeroCopyTracker.sendCompleted();
+        sentBytes += (size_t)sent;
+        statistics.add(SocketStats::BYTES_OUT, (uint64_t)sent);
+        if (sentBytes < total)
+        {
+            statistics.add(SocketStats::SHORT_WRITES);
+        }
+    }
+
+    /* An interrupted message stays open for the resuming call, otherwise a_release is due once its ids complete*/
+    bool resumable = (result.status == SocketStatus::WOULD_BLOCK || result.status == SocketStatus::TIMEOUT);
+    if (!resumable)
+    {
+        zeroCopyTracker.close();
+    }
+    if (sentBytes == total)
+    {
+        statistics.add(SocketStats::MESSAGES_OUT);
+    }
+    pollZeroCopyCompletions();
+    result.bytes = sentBytes;
+    return result;
+}
+
+size_t TCPSocket::pollZeroCopyCompletions()
+{
+    return (sock >= 0) ? zeroCopyTracker.readCompletions(sock) : 0;
+}
+
+bool TCPSocket::waitZeroCopyCompletions(int a_timeoutMs)
+{
+    /* Error-queue notifications are signalled as POLLERR, which poll reports without being requested*/
+    pollZeroCopyCompletions();
+    while (zeroCopyTracker.hasOutstandingCalls() && sock >= 0)
+    {
+        struct pollfd waitFor = {sock, 0, 0};
+        if (::poll(&waitFor, 1, a_timeoutMs) <= 0)
+        {
+            return false;
+        }
+        pollZeroCopyCompletions();
+    }
+    return zeroCopyTracker.pendingBuffers() == 0;
+}
+
+size_t TCPSocket::pendingZeroCopyBuffers() const
+{
+    return zeroCopyTracker.pendingBuffers();
+}
+
+size_t TCPSocket::zeroCopyFallbacks() const
+{
+    return zeroCopyTracker.copiedCount();
+}
+
+void TCPSocket::queueNextSend()
+{
+    if (pendingOutput.empty() || sock < 0)
+    {
+        return;
+    }
+    /* swap keeps both strings' capacity, so steady-state sending doesn't allocate*/
+    sendRequest.data.swap(pendingOutput);
+    pendingOutput.clear();
+    sendRequest.offset = 0;
+    sendInFlight = true;
+    ring->prepareSend(sock, sendRequest.data.data(), sendRequest.data.size(), MSG_NOSIGNAL, &sendRequest);
+}
+
+void TCPSocket::UringSendRequest::complete(int a_result)
+{
+    IOUring::Request::complete(a_result);
+    if (a_result < 0)
+    {
+        /* Reported by the next send() (the queued bytes are dropped, the stream is broken anyway)*/
+        owner->uringSendError = -a_result;
+        owner->pendingOutput.clear();
+        owner->sendInFlight = false;
+        return;
+    }
+
+    /* A short send is resumed from where it stopped before anything queued behind it*/
+    offset += (size_t)a_result;
+    if (offset < data.size())
+    {
+        owner->ring->prepareSend(owner->sock, data.data() + offset, data.size() - offset, MSG_NOSIGNAL, this);
+        return;
+    }
+    owner->sendInFlight = false;
+    owner->queueNextSend();
+}
+
+SocketResult TCPSocket::recvBytes(char *a_buffer, size_t a_length, int a_flags)
+{
+    /*
+     ! Receive deadline:
+     * With a deadline the recv never blocks (MSG_DONTWAIT); on EAGAIN poll waits for POLLIN
+     * for the time left. Without one a blocking socket blocks as before and a non-blocking
+     * socket returns WOULD_BLOCK. A caller passing MSG_DONTWAIT never waits.
+     * In busy-poll mode a receive that would wait spins first (see setBusyPoll).
+     */
+    Deadline deadline((a_flags & MSG_DONTWAIT) ? -1 : timeouts.receiveMs);
+    bool mayWait = backend == IOBackendType::BLOCKING && !nonBlocking && !(a_flags & MSG_DONTWAIT);
+    SpinBudget spin(mayWait ? busyPollBudgetUs : 0);
+    while (true)
+    {
+        ssize_t bytes;
+        if (backend == IOBackendType::IO_URING)
+        {
+            /* waitFor submits the receive together with every queued send of this thread in one io_uring_enter*/
+            if (!deadline.isInfinite())
+            {
+                ring->submit();
+                SocketResult ready = deadline.waitUntilReady(sock, POLLIN);
+                if (!ready.ok())
+                {
+                    return ready;
+                }
+            }
+            IOUring::Request request;
+            ring->prepareRecv(sock, a_buffer, a_length, a_flags, &request);
+            ring->waitFor(request);
+            bytes = request.result;
+            if (bytes < 0)
+            {
+                errno = -request.result;
+            }
+        }
+        else
+        {
+            bytes = ::recv(sock, a_buffer, a_length, a_flags | ((deadline.isInfinite() && !spin.isSpinning()) ? 0 : MSG_DONTWAIT));
+        }
+        statistics.add(SocketStats::SYSCALLS);
+
+        if (bytes > 0)
+        {
+            if (spin.isSpinning())
+            {
+                statistics.add(SocketStats::SPIN_RECEIVES);
+            }
+            statistics.add(SocketStats::BYTES_IN, (uint64_t)bytes);
+            if ((size_t)bytes < a_length)
+            {
+                statistics.add(SocketStats::SHORT_READS);
+            }
+            return SocketResult::success((size_t)bytes);
+        }
+        if (bytes == 0)
+        {
+            return SocketResult(SocketStatus::PEER_CLOSED, 0, 0);
+        }
+        int error = errno;
+        if (error == EINTR)
+        {
+            continue;
+        }
+        if ((error == EAGAIN || error == EWOULDBLOCK) && spin.isSpinning())
+        {
+            if (!spin.keepSpinning())
+            {
+                statistics.add(SocketStats::SPIN_FALLBACKS); /* The next call waits as usual*/
+            }
+            continue;
+        }
+        statistics.add((error == EAGAIN || error == EWOULDBLOCK) ? SocketStats::WOULD_BLOCKS : SocketStats::ERRORS);
+        if ((error == EAGAIN || error == EWOULDBLOCK) && !deadline.isInfinite())
+        {
+            SocketResult ready = deadline.waitUntilReady(sock, POLLIN);
+            if (!ready.ok())
+            {
+                return ready;
+            }
+            continue;
+        }
+        return SocketResult::fromErrno(error);
+    }
+}
+
+SocketResult TCPSocket::fillDecoder()
+{
+    /*
+     * One read straight into the decoder's free space. It may complete any number of frames
+     * (all are kept) or only part of one.
+     */
+    char *space = decoder.prepare(4096);
+    SocketResult result = recvBytes(space, decoder.writableSize());
+    if (result.ok())
+    {
+        decoder.commit(result.bytes);
+    }
+    return result;
 }
 
 std::string TCPSocket::receive() 
 {
-    /* Create a vector that will grow as needed*/
-    std::vector<char> buffer(1024); /* Initial size of 1024, but can grow as needed*/
+    std::string message;
+    receive(message);
+    return message;
+}
+
+SocketResult TCPSocket::receive(std::string &a_message) 
+{
+    a_message.clear();
+    if (sock < 0)
+    {
+        return socketClosed();
+    }
+
+    /*
+     ! LENGTH_PREFIXED framing:
+     * A frame already buffered by an earlier read is returned without any system call,
+     * otherwise the socket is read until one frame is complete.
+     */
+    if (framing == FramingType::LENGTH_PREFIXED)
+    {
+        const char *frame;
+        size_t frameLength;
+        while (!decoder.nextFrame(frame, frameLength))
+        {
+            if (decoder.isCorrupted())
+            {
+                /* Invalid frame length: the stream can't be resynchronised, it is discarded*/
+                decoder.reset();
+                return SocketResult(SocketStatus::ERROR, 0, EPROTO);
+            }
+            SocketResult result = fillDecoder();
+            if (!result.ok())
+            {
+                return result;
+            }
+        }
+        a_message.assign(frame, frameLength);
+        statistics.add(SocketStats::MESSAGES_IN);
+        return SocketResult::success(frameLength);
+    }
+
+    /* A pooled buffer (see BufferPool) that will grow as needed, no heap allocation per receive*/
+    BufferPool::Buffer buffer(1024); /* Initial size of 1024, but can grow as needed*/
     /**
      * ! recv Function
      * * The recv function is specifically designed for receiving data over sockets.
@@ -189,22 +1007,179 @@ std::string TCPSocket::receive()
      *
      */
 
-    int bytes = ::recv(sock, buffer.data(), buffer.size(), 0);
+    /* Nothing to read (WOULD_BLOCK), timeout, an error, or the peer closed the connection*/
+    SocketResult result = recvBytes(buffer.data(), buffer.capacity());
+    if (!result.ok())
+    {
+        return result;
+    }
+    size_t bytes = result.bytes;
+
+    /*
+     * If the buffer was filled, more data may already be queued: the buffer is doubled and the rest
+     * is collected with MSG_DONTWAIT, so a message of exactly the buffer size never blocks
+     * waiting for bytes that aren't coming. The growth stops at the frame size limit, a peer
+     * that keeps writing can't make one receive buffer its whole stream; the rest is left for
+     * the next receive.
+     */
+    while (bytes == buffer.capacity() && buffer.capacity() < decoder.getMaxFrameSize())
+    {
+        buffer.grow(buffer.capacity() * 2, bytes); /* Double the buffer size for the next read (next size class)*/
+        SocketResult additional = recvBytes(buffer.data() + bytes, buffer.capacity() - bytes, MSG_DONTWAIT);
+
+        /*This is a safeguard to handle cases where the second recv may not receive any additional data.*/
+        if (!additional.ok())
+        {
+            break;
+        }
+        bytes += additional.bytes;
+    }
+
+    a_message.assign(buffer.data(), bytes); /* Construct a string from the received data*/
+    statistics.add(SocketStats::MESSAGES_IN);
+    return SocketResult::success(bytes);
+}
+
+SocketResult TCPSocket::receive(char *a_buffer, size_t a_length)
+{
+    /*
+     * Allocation-free variant of receive(): one recv straight into the caller's buffer.
+     * The caller keeps (and reuses) the memory, so the hot receive path never touches the heap.
+     * With LENGTH_PREFIXED framing one whole frame is copied out; a frame larger than
+     * a_length stays buffered and ERROR/EMSGSIZE is returned.
+     */
+    if (sock < 0)
+    {
+        return socketClosed();
+    }
+    if (framing == FramingType::LENGTH_PREFIXED)
+    {
+        SocketResult ready = awaitFrame();
+        if (!ready.ok())
+        {
+            return ready;
+        }
+        /* The length is checked before consuming so an oversized frame isn't lost*/
+        size_t frameLength = decoder.nextFrameLength();
+        if (frameLength > a_length)
+        {
+            return SocketResult(SocketStatus::ERROR, 0, EMSGSIZE);
+        }
+        const char *frame;
+        decoder.nextFrame(frame, frameLength);
+        memcpy(a_buffer, frame, frameLength);
+        statistics.add(SocketStats::MESSAGES_IN);
+        return SocketResult::success(frameLength);
+    }
+    SocketResult result = recvBytes(a_buffer, a_length);
+    if (result.ok())
+    {
+        statistics.add(SocketStats::MESSAGES_IN);
+    }
+    return result;
+}
+
+SocketResult TCPSocket::receiveView(const char *&a_data, size_t &a_length)
+{
+    /*
+     * LENGTH_PREFIXED: the frame is handed out where it was received, inside the decoder.
+     * RAW: one read into the socket's view buffer, the message is whatever that read returned.
+     */
+    if (sock < 0)
+    {
+        return socketClosed();
+    }
+    if (framing == FramingType::LENGTH_PREFIXED)
+    {
+        SocketResult ready = awaitFrame();
+        if (!ready.ok())
+        {
+            return ready;
+        }
+        decoder.nextFrame(a_data, a_length);
+        statistics.add(SocketStats::MESSAGES_IN);
+        return SocketResult::success(a_length);
+    }
+    if (viewBuffer.data() == nullptr)
+    {
+        viewBuffer = BufferPool::Buffer(BufferPool::MAX_BUFFER_SIZE);
+    }
+    SocketResult result = recvBytes(viewBuffer.data(), viewBuffer.capacity());
+    if (result.ok())
+    {
+        statistics.add(SocketStats::MESSAGES_IN);
+        a_data = viewBuffer.data();
+        a_length = result.bytes;
+    }
+    return result;
+}
 
-    /* If more data is received than the buffer can hold, resize the buffer*/
-    if (bytes == buffer.size())
+SocketResult TCPSocket::awaitFrame()
+{
+    /* Reads until the decoder holds one complete frame (a buffered frame costs no system call)*/
+    while (!decoder.hasFrame())
     {
-        buffer.resize(buffer.size() * 2); /* Double the buffer size for the next read*/
-        bytes += ::recv(sock, buffer.data() + bytes, buffer.size() - bytes, 0);
+        if (decoder.isCorrupted())
+        {
+            return SocketResult(SocketStatus::ERROR, 0, EPROTO);
+        }
+        SocketResult result = fillDecoder();
+        if (!result.ok())
+        {
+            return result;
+        }
     }
+    return SocketResult::success();
+}
 
-    return std::string(buffer.data(), bytes); /* Construct a string from the received data*/
+void TCPSocket::setFraming(FramingType a_framing)
+{
+    framing = a_framing;
+    decoder.reset();
+}
+
+bool TCPSocket::hasPendingMessage() const
+{
+    return (framing == FramingType::LENGTH_PREFIXED) && decoder.hasFrame();
+}
+
+void TCPSocket::flush()
+{
+    if (backend == IOBackendType::IO_URING)
+    {
+        ring->submit();
+    }
+    if (tuning.cork && sock >= 0)
+    {
+        /* Uncorking sends the partial segment held back by TCP_CORK, then the socket is corked again*/
+        int value = 0;
+        setsockopt(sock, IPPROTO_TCP, TCP_CORK, &value, sizeof(value));
+        value = 1;
+        setsockopt(sock, IPPROTO_TCP, TCP_CORK, &value, sizeof(value));
+    }
 }
+
 void TCPSocket::shutdown() 
 {
 
     if (sock >= 0)
     {
+        /* Zero-copy buffers are released once the kernel is done with them (bounded wait)*/
+        zeroCopyTracker.close();
+        if (zeroCopyTracker.pendingBuffers() > 0)
+        {
+            waitZeroCopyCompletions(1000);
+        }
+
+        /* Queued io_uring sends still reference this descriptor and must finish before it is closed*/
+        if (backend == IOBackendType::IO_URING)
+        {
+            while (sendInFlight)
+            {
+                ring->waitFor(sendRequest);
+            }
+        }
+
         /**
          * !::shutdown(sock, SHUT_RDWR);
          * * Purpose: The shutdown function is used to partially or fully close a connection on a socket without immediately releasing the socket file descriptor (sock).
@@ -227,5 +1202,20 @@ void TCPSocket::shutdown()
          */
         close(sock);
         sock = -1;
+
+        /* Closed: no more completions can be reported, whatever is left is handed back*/
+        zeroCopyTracker.releaseAll();
+    }
+}
+
+TCPSocket::~TCPSocket()
+{
+    /* The in-flight io_uring send request lives inside this object*/
+    if (backend == IOBackendType::IO_URING)
+    {
+        while (sendInFlight)
+        {
+            ring->waitFor(sendRequest);
+        }
     }
 }
@@ -0,0 +1,120 @@
+#include "TelemetryMessage.hpp"
+#include "ByteOrder.hpp"
+#include <chrono>
+#include <cstring>
+
+TelemetryReading TelemetryReading::fromInteger(uint16_t a_sensorId, int64_t a_value, TelemetryUnit a_unit)
+{
+    TelemetryReading reading;
+    reading.sensorId = a_sensorId;
+    reading.valueType = TelemetryValueType::INT64;
+    reading.unit = a_unit;
+    reading.integer = a_value;
+    return reading;
+}
+
+TelemetryReading TelemetryReading::fromUnsigned(uint16_t a_sensorId, uint64_t a_value, TelemetryUnit a_unit)
+{
+    TelemetryReading reading;
+    reading.sensorId = a_sensorId;
+    reading.valueType = TelemetryValueType::UINT64;
+    reading.unit = a_unit;
+    reading.unsignedInteger = a_value;
+    return reading;
+}
+
+TelemetryReading TelemetryReading::fromReal(uint16_t a_sensorId, double a_value, TelemetryUnit a_unit)
+{
+    TelemetryReading reading;
+    reading.sensorId = a_sensorId;
+    reading.valueType = TelemetryValueType::FLOAT64;
+    reading.unit = a_unit;
+    reading.real = a_value;
+    return reading;
+}
+
+TelemetryReading TelemetryReading::fromBool(uint16_t a_sensorId, bool a_value)
+{
+    TelemetryReading reading;
+    reading.sensorId = a_sensorId;
+    reading.valueType = TelemetryValueType::BOOL;
+    reading.integer = a_value ? 1 : 0;
+    return reading;
+}
+
+size_t TelemetryMessage::encode(const TelemetryHeader &a_header, const TelemetryReading *a_readings, size_t a_readingCount,
+                                char *a_buffer, size_t a_capacity)
+{
+    size_t size = encodedSize(a_readingCount);
+    if (a_readingCount > MAX_READINGS || size > a_capacity)
+    {
+        return 0;
+    }
+    a_buffer[0] = (char)VERSION;
+    a_buffer[1] = (char)a_header.type;
+    storeBigEndian16(a_buffer + 2, (uint16_t)a_readingCount);
+    storeBigEndian32(a_buffer + 4, a_header.deviceId);
+    storeBigEndian32(a_buffer + 8, a_header.sequence);
+    storeBigEndian64(a_buffer + 12, a_header.timestampUs);
+
+    char *at = a_buffer + HEADER_SIZE;
+    for (size_t i = 0; i < a_readingCount; i++, at += READING_SIZE)
+    {
+        storeBigEndian16(at, a_readings[i].sensorId);
+        at[2] = (char)a_readings[i].valueType;
+        at[3] = (char)a_readings[i].unit;
+        uint64_t bits;
+        memcpy(&bits, &a_readings[i].integer, sizeof(bits)); /* The union's 64 bits, whatever the value type*/
+        storeBigEndian64(at + 4, bits);
+    }
+    return size;
+}
+
+bool TelemetryMessage::decodeHeader(const char *a_data, size_t a_length, TelemetryHeader &a_header)
+{
+    if (a_length < HEADER_SIZE || (uint8_t)a_data[0] != VERSION)
+    {
+        return false;
+    }
+    uint8_t type = (uint8_t)a_data[1];
+    if (type < (uint8_t)TelemetryType::READINGS || type > (uint8_t)TelemetryType::ACK)
+    {
+        return false;
+    }
+    uint16_t readingCount = loadBigEndian16(a_data + 2);
+    if (a_length < encodedSize(readingCount))
+    {
+        return false;
+    }
+    a_header.type = (TelemetryType)type;
+    a_header.readingCount = readingCount;
+    a_header.deviceId = loadBigEndian32(a_data + 4);
+    a_header.sequence = loadBigEndian32(a_data + 8);
+    a_header.timestampUs = loadBigEndian64(a_data + 12);
+    return true;
+}
+
+bool TelemetryMessage::decodeReading(const char *a_data, size_t a_length, size_t a_index, TelemetryReading &a_reading)
+{
+    if (a_length < HEADER_SIZE || a_index >= loadBigEndian16(a_data + 2) || a_length < encodedSize(a_index + 1))
+    {
+        return false;
+    }
+    const char *at = a_data + HEADER_SIZE + a_index * READING_SIZE;
+    uint8_t valueType = (uint8_t)at[2];
+    if (valueType < (uint8_t)TelemetryValueType::INT64 || valueType > (uint8_t)TelemetryValueType::BOOL)
+    {
+        return false;
+    }
+    a_reading.sensorId = loadBigEndian16(at);
+    a_reading.valueType = (TelemetryValueType)valueType;
+    a_reading.unit = (TelemetryUnit)(uint8_t)at[3];
+    uint64_t bits = loadBigEndian64(at + 4);
+    memcpy(&a_reading.integer, &bits, sizeof(bits));
+    return true;
+}
+
+uint64_t TelemetryMessage::nowMicroseconds()
+{
+    return (uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+}
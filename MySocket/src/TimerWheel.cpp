@@ -0,0 +1,308 @@
+#include "TimerWheel.hpp"
+#include <algorithm>
+
+TimerWheel::TimerWheel(uint64_t a_startTick) : freeHead(NONE), activeCount(0), occupied{}, levelCounts{}, firing(NONE), currentTick(a_startTick)
+{
+    for (size_t level = 0; level < LEVEL_COUNT; level++)
+    {
+        for (size_t slot = 0; slot < SLOT_COUNT; slot++)
+        {
+            slots[level][slot] = NONE;
+        }
+    }
+}
+
+int32_t TimerWheel::allocate()
+{
+    if (freeHead != NONE)
+    {
+        int32_t index = freeHead;
+        freeHead = timers[index].next;
+        timers[index].next = NONE;
+        return index;
+    }
+    timers.emplace_back();
+    return (int32_t)(timers.size() - 1);
+}
+
+void TimerWheel::release(int32_t a_index)
+{
+    Timer &timer = timers[a_index];
+    timer.callback = nullptr;
+    timer.generation = (timer.generation + 1 == 0) ? 1 : timer.generation + 1;
+    timer.previous = NONE;
+    timer.next = freeHead;
+    freeHead = a_index;
+}
+
+void TimerWheel::link(int32_t a_index, int32_t *a_list, int32_t a_level, int32_t a_slot)
+{
+    Timer &timer = timers[a_index];
+    timer.list = a_list;
+    timer.level = a_level;
+    timer.slot = a_slot;
+    timer.previous = NONE;
+    timer.next = *a_list;
+    if (*a_list != NONE)
+    {
+        timers[*a_list].previous = a_index;
+    }
+    *a_list = a_index;
+    if (a_level != NONE)
+    {
+        levelCounts[a_level]++;
+    }
+    if (a_level == 0)
+    {
+        occupied[a_slot / 64] |= uint64_t(1) << (a_slot % 64);
+    }
+}
+
+void TimerWheel::unlink(int32_t a_index)
+{
+    Timer &timer = timers[a_index];
+    if (timer.previous != NONE)
+    {
+        timers[timer.previous].next = timer.next;
+    }
+    else
+    {
+        *timer.list = timer.next;
+    }
+    if (timer.next != NONE)
+    {
+        timers[timer.next].previous = timer.previous;
+    }
+    if (timer.level != NONE)
+    {
+        levelCounts[timer.level]--;
+    }
+    if (timer.level == 0 && *timer.list == NONE)
+    {
+        occupied[timer.slot / 64] &= ~(uint64_t(1) << (timer.slot % 64));
+    }
+    timer.list = nullptr;
+    timer.previous = NONE;
+    timer.next = NONE;
+}
+
+void TimerWheel::place(int32_t a_index)
+{
+    /*
+     ! Choosing the level:
+     * The distance to the expiry picks the level, the expiry's own bits at that level pick the slot.
+     * A level L slot is cascaded when the low 8*L bits of the tick wrap to zero, which is always
+     * before the timer is due and leaves it less than 256^L ticks away (the next level down).
+     */
+    uint64_t expiry = timers[a_index].expiry;
+    uint64_t delta = (expiry > currentTick) ? expiry - currentTick : 0;
+    if (delta == 0)
+    {
+        expiry = currentTick; /* Only while cascading: fires in the tick being processed*/
+    }
+    for (size_t level = 0; level < LEVEL_COUNT; level++)
+    {
+        unsigned shift = (unsigned)level * SLOT_BITS;
+        if (level == LEVEL_COUNT - 1 || delta < (uint64_t(1) << (shift + SLOT_BITS)))
+        {
+            if (level == LEVEL_COUNT - 1 && delta >= (uint64_t(1) << (shift + SLOT_BITS)))
+            {
+                expiry = currentTick + (uint64_t(1) << (shift + SLOT_BITS)) - 1; /* Beyond the wheel: parked in the farthest slot*/
+            }
+            int32_t slot = (int32_t)((expiry >> shift) & (SLOT_COUNT - 1));
+            link(a_index, &slots[level][slot], (int32_t)level, slot);
+            return;
+        }
+    }
+}
+
+void TimerWheel::cascade(size_t a_level)
+{
+    /* The whole slot is detached first, re-placing never puts a timer back into the list being walked*/
+    int32_t slot = (int32_t)((currentTick >> (a_level * SLOT_BITS)) & (SLOT_COUNT - 1));
+    int32_t index = slots[a_level][slot];
+    slots[a_level][slot] = NONE;
+    while (index != NONE)
+    {
+        int32_t next = timers[index].next;
+        levelCounts[a_level]--;
+        timers[index].list = nullptr;
+        place(index);
+        index = next;
+    }
+}
+
+size_t TimerWheel::expireCurrent()
+{
+    int32_t slot = (int32_t)(currentTick & (SLOT_COUNT - 1));
+    if (slots[0][slot] == NONE)
+    {
+        return 0;
+    }
+
+    /* Moved to the firing list, where a callback can still cancel or reschedule any of them*/
+    int32_t index = slots[0][slot];
+    slots[0][slot] = NONE;
+    occupied[slot / 64] &= ~(uint64_t(1) << (slot % 64));
+    while (index != NONE)
+    {
+        int32_t next = timers[index].next;
+        levelCounts[0]--;
+        timers[index].list = nullptr;
+        link(index, &firing, NONE, NONE);
+        index = next;
+    }
+
+    size_t fired = 0;
+    while (firing != NONE)
+    {
+        index = firing;
+        unlink(index);
+        fired++;
+        Timer &timer = timers[index];
+        if (timer.period == 0)
+        {
+            TimerCallback callback = std::move(timer.callback);
+            release(index);
+            activeCount--;
+            callback();
+            continue;
+        }
+
+        /*
+         * Periodic: the next run is placed before the callback (which may cancel or reschedule it).
+         * It stays on its original cadence; runs missed by a late loop are skipped, not replayed.
+         */
+        timer.expiry += timer.period;
+        if (timer.expiry <= currentTick)
+        {
+            timer.expiry = currentTick + 1;
+        }
+        place(index);
+        uint32_t generation = timer.generation;
+        TimerCallback callback = std::move(timer.callback);
+        callback();
+        /* The slab may have grown during the callback, the timer is looked up again*/
+        if (timers[index].generation == generation && timers[index].list != nullptr)
+        {
+            timers[index].callback = std::move(callback);
+        }
+    }
+    return fired;
+}
+
+int32_t TimerWheel::find(TimerId a_id) const
+{
+    uint32_t index = (uint32_t)(a_id & 0xffffffffu);
+    uint32_t generation = (uint32_t)(a_id >> 32);
+    if (index >= timers.size() || timers[index].generation != generation || timers[index].list == nullptr)
+    {
+        return NONE;
+    }
+    return (int32_t)index;
+}
+
+TimerWheel::TimerId TimerWheel::schedule(uint64_t a_expiryTick, uint64_t a_period, TimerCallback a_callback)
+{
+    int32_t index = allocate();
+    Timer &timer = timers[index];
+    timer.callback = std::move(a_callback);
+    timer.expiry = (a_expiryTick > currentTick) ? a_expiryTick : currentTick + 1;
+    timer.period = a_period;
+    place(index);
+    activeCount++;
+    return ((TimerId)timer.generation << 32) | (uint32_t)index;
+}
+
+bool TimerWheel::reschedule(TimerId a_id, uint64_t a_expiryTick)
+{
+    int32_t index = find(a_id);
+    if (index == NONE)
+    {
+        return false;
+    }
+    unlink(index);
+    timers[index].expiry = (a_expiryTick > currentTick) ? a_expiryTick : currentTick + 1;
+    place(index);
+    return true;
+}
+
+bool TimerWheel::cancel(TimerId a_id)
+{
+    int32_t index = find(a_id);
+    if (index == NONE)
+    {
+        return false;
+    }
+    unlink(index);
+    release(index);
+    activeCount--;
+    return true;
+}
+
+size_t TimerWheel::advance(uint64_t a_tick)
+{
+    size_t fired = 0;
+    while (currentTick < a_tick)
+    {
+        if (activeCount == 0)
+        {
+            currentTick = a_tick;
+            break;
+        }
+        /* Nothing due in level 0: jump straight to the next cascade (or to a_tick)*/
+        if (levelCounts[0] == 0)
+        {
+            uint64_t boundary = (currentTick | (SLOT_COUNT - 1)) + 1;
+            if (boundary > a_tick)
+            {
+                currentTick = a_tick;
+                break;
+            }
+            currentTick = boundary - 1;
+        }
+        currentTick++;
+        /* Highest level first: its timers may land in the lower slot cascaded next*/
+        for (size_t level = LEVEL_COUNT - 1; level > 0; level--)
+        {
+            uint64_t mask = (uint64_t(1) << (level * SLOT_BITS)) - 1;
+            if ((currentTick & mask) == 0)
+            {
+                cascade(level);
+            }
+        }
+        fired += expireCurrent();
+    }
+    return fired;
+}
+
+int64_t TimerWheel::ticksUntilNext() const
+{
+    if (activeCount == 0)
+    {
+        return -1;
+    }
+    int64_t next = -1;
+    if (levelCounts[0] > 0)
+    {
+        /* First occupied level 0 slot after the current one (slots wrap around)*/
+        for (size_t distance = 1; distance < SLOT_COUNT; distance++)
+        {
+            size_t slot = (size_t)((currentTick + distance) & (SLOT_COUNT - 1));
+            uint64_t word = occupied[slot / 64] >> (slot % 64);
+            if (word == 0)
+            {
+                distance += 63 - (slot % 64); /* Rest of this word is empty*/
+                continue;
+            }
+            next = (int64_t)(distance + __builtin_ctzll(word));
+            break;
+        }
+    }
+    if (activeCount > levelCounts[0])
+    {
+        int64_t boundary = (int64_t)(SLOT_COUNT - (currentTick & (SLOT_COUNT - 1)));
+        next = (next < 0) ? boundary : std::min(next, boundary);
+    }
+    return next;
+}
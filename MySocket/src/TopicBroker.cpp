@@ -0,0 +1,178 @@
+#include "TopicBroker.hpp"
+#include "ByteOrder.hpp"
+#include <algorithm>
+
+TopicBroker::TopicBroker(Socket *a_listenSocket, EventLoop &a_loop, int a_port, const std::string a_ip)
+    : channel(a_listenSocket, a_loop, a_port, a_ip)
+{
+    channel.setFraming(FramingType::LENGTH_PREFIXED);
+    channel.onReadable([this](int a_connectionId, Socket &a_connection)
+                       {
+                           /* Every frame already received is handled in place, until the socket has nothing more*/
+                           const char *frame;
+                           size_t length;
+                           while (true)
+                           {
+                               SocketResult result = a_connection.receiveView(frame, length);
+                               if (!result.ok())
+                               {
+                                   if (result.status == SocketStatus::ERROR)
+                                   {
+                                       channel.close(a_connectionId); /* Corrupted stream (EPROTO) or a failed read*/
+                                   }
+                                   return;
+                               }
+                               handleFrame(a_connectionId, frame, length);
+                           } });
+    channel.onDisconnect([this](int a_connectionId, Socket &)
+                         { removeConnection(a_connectionId); });
+}
+
+SocketResult TopicBroker::start()
+{
+    return channel.start();
+}
+
+void TopicBroker::stop()
+{
+    channel.stop(); /* Closing the connections also drops their subscriptions (onDisconnect)*/
+}
+
+bool TopicBroker::parse(const char *a_frame, size_t a_length, Operation &a_operation, std::string_view &a_topic, std::string_view &a_payload)
+{
+    if (a_length < HEADER_SIZE)
+    {
+        return false;
+    }
+    uint8_t operation = (uint8_t)a_frame[0];
+    size_t topicLength = loadBigEndian16(a_frame + 1);
+    if (operation < (uint8_t)Operation::SUBSCRIBE || operation > (uint8_t)Operation::MESSAGE || a_length < HEADER_SIZE + topicLength)
+    {
+        return false;
+    }
+    a_operation = (Operation)operation;
+    a_topic = std::string_view(a_frame + HEADER_SIZE, topicLength);
+    a_payload = std::string_view(a_frame + HEADER_SIZE + topicLength, a_length - HEADER_SIZE - topicLength);
+    return true;
+}
+
+void TopicBroker::handleFrame(int a_connectionId, const char *a_frame, size_t a_length)
+{
+    /* Malformed frames and invalid filters/topics are ignored, the connection stays usable*/
+    Operation operation;
+    std::string_view topic;
+    std::string_view payload;
+    if (!parse(a_frame, a_length, operation, topic, payload))
+    {
+        return;
+    }
+    switch (operation)
+    {
+    case Operation::SUBSCRIBE:
+        if (subscriptions.subscribe(topic, a_connectionId))
+        {
+            filters[a_connectionId].emplace_back(topic);
+        }
+        break;
+    case Operation::UNSUBSCRIBE:
+        if (subscriptions.unsubscribe(topic, a_connectionId))
+        {
+            std::vector<std::string> &own = filters[a_connectionId];
+            own.erase(std::find(own.begin(), own.end(), topic));
+        }
+        break;
+    case Operation::PUBLISH:
+    {
+        if (!TopicTrie::isValidTopic(topic))
+        {
+            break;
+        }
+        /* The received frame is forwarded as is, only the operation byte is replaced*/
+        static const char message = (char)Operation::MESSAGE;
+        MessageSegment segments[2] = {{&message, 1}, {a_frame + 1, a_length - 1}};
+        deliver(topic, segments, 2);
+        break;
+    }
+    case Operation::MESSAGE:
+        break; /* Only sent by the broker*/
+    }
+}
+
+void TopicBroker::removeConnection(int a_connectionId)
+{
+    auto entry = filters.find(a_connectionId);
+    if (entry == filters.end())
+    {
+        return;
+    }
+    for (const std::string &filter : entry->second)
+    {
+        subscriptions.unsubscribe(filter, a_connectionId);
+    }
+    filters.erase(entry);
+}
+
+size_t TopicBroker::deliver(std::string_view a_topic, const MessageSegment *a_segments, size_t a_count)
+{
+    /*
+     * Sent on each matching connection in turn. A slow subscriber's messages wait in its send
+     * queue; once that queue is congested it misses messages, the others are not held up by it.
+     */
+    subscriptions.match(a_topic, matches);
+    size_t delivered = 0;
+    for (int connectionId : matches)
+    {
+        if (channel.send(connectionId, a_segments, a_count).ok())
+        {
+            delivered++;
+        }
+    }
+    return delivered;
+}
+
+size_t TopicBroker::publish(std::string_view a_topic, const char *a_payload, size_t a_length)
+{
+    if (!TopicTrie::isValidTopic(a_topic) || a_topic.size() > UINT16_MAX)
+    {
+        return 0;
+    }
+    char header[HEADER_SIZE];
+    header[0] = (char)Operation::MESSAGE;
+    storeBigEndian16(header + 1, (uint16_t)a_topic.size());
+    MessageSegment segments[3] = {{header, HEADER_SIZE}, {a_topic.data(), a_topic.size()}, {a_payload, a_length}};
+    return deliver(a_topic, segments, 3);
+}
+
+SocketResult TopicBroker::sendFrame(Channel &a_channel, Operation a_operation, std::string_view a_topic, const char *a_payload, size_t a_payloadLength)
+{
+    if (a_topic.size() > UINT16_MAX)
+    {
+        return SocketResult(SocketStatus::ERROR, 0, EINVAL);
+    }
+    char header[HEADER_SIZE];
+    header[0] = (char)a_operation;
+    storeBigEndian16(header + 1, (uint16_t)a_topic.size());
+    MessageSegment segments[3] = {{header, HEADER_SIZE}, {a_topic.data(), a_topic.size()}, {a_payload, a_payloadLength}};
+    return a_channel.send(segments, 3);
+}
+
+SocketResult TopicBroker::subscribe(Channel &a_channel, std::string_view a_filter)
+{
+    return sendFrame(a_channel, Operation::SUBSCRIBE, a_filter, nullptr, 0);
+}
+
+SocketResult TopicBroker::unsubscribe(Channel &a_channel, std::string_view a_filter)
+{
+    return sendFrame(a_channel, Operation::UNSUBSCRIBE, a_filter, nullptr, 0);
+}
+
+SocketResult TopicBroker::publish(Channel &a_channel, std::string_view a_topic, const char *a_payload, size_t a_length)
+{
+    return sendFrame(a_channel, Operation::PUBLISH, a_topic, a_payload, a_length);
+}
+
+// Destructor for TopicBroker
+TopicBroker::~TopicBroker()
+{
+    stop();
+}
@@ -0,0 +1,179 @@
+#include "TopicTrie.hpp"
+#include <algorithm>
+
+TopicTrie::TopicTrie() : subscriptionCount(0) {}
+
+bool TopicTrie::nextLevel(std::string_view &a_rest, std::string_view &a_level)
+{
+    /* Splits off the first level, returns false when it was the last one*/
+    size_t separator = a_rest.find('/');
+    if (separator == std::string_view::npos)
+    {
+        a_level = a_rest;
+        a_rest = std::string_view();
+        return false;
+    }
+    a_level = a_rest.substr(0, separator);
+    a_rest = a_rest.substr(separator + 1);
+    return true;
+}
+
+bool TopicTrie::isValidFilter(std::string_view a_filter)
+{
+    if (a_filter.empty())
+    {
+        return false;
+    }
+    std::string_view rest = a_filter;
+    std::string_view level;
+    bool more = true;
+    while (more)
+    {
+        more = nextLevel(rest, level);
+        bool wildcard = level.find_first_of("+#") != std::string_view::npos;
+        if (wildcard && level.size() != 1)
+        {
+            return false; /* A wildcard is a whole level: "a/b+" is invalid*/
+        }
+        if (level == "#" && more)
+        {
+            return false; /* "#" only as the last level*/
+        }
+    }
+    return true;
+}
+
+bool TopicTrie::isValidTopic(std::string_view a_topic)
+{
+    return !a_topic.empty() && a_topic.find_first_of("+#") == std::string_view::npos;
+}
+
+bool TopicTrie::subscribe(std::string_view a_filter, int a_subscriber)
+{
+    if (!isValidFilter(a_filter))
+    {
+        return false;
+    }
+    Node *node = &root;
+    std::string_view rest = a_filter;
+    std::string_view level;
+    bool more = true;
+    while (more)
+    {
+        more = nextLevel(rest, level);
+        std::unique_ptr<Node> *child;
+        if (level == "+")
+        {
+            child = &node->singleLevel;
+        }
+        else if (level == "#")
+        {
+            child = &node->multiLevel;
+        }
+        else
+        {
+            auto entry = node->children.find(level);
+            if (entry == node->children.end())
+            {
+                entry = node->children.emplace(std::string(level), nullptr).first;
+            }
+            child = &entry->second;
+        }
+        if (!*child)
+        {
+            child->reset(new Node());
+        }
+        node = child->get();
+    }
+    if (std::find(node->subscribers.begin(), node->subscribers.end(), a_subscriber) != node->subscribers.end())
+    {
+        return false;
+    }
+    node->subscribers.push_back(a_subscriber);
+    subscriptionCount++;
+    return true;
+}
+
+bool TopicTrie::removeFrom(Node &a_node, std::string_view a_rest, bool a_atEnd, int a_subscriber)
+{
+    if (a_atEnd)
+    {
+        auto entry = std::find(a_node.subscribers.begin(), a_node.subscribers.end(), a_subscriber);
+        if (entry == a_node.subscribers.end())
+        {
+            return false;
+        }
+        a_node.subscribers.erase(entry);
+        return true;
+    }
+
+    /* Down the filter's path, nodes left empty are pruned on the way back*/
+    std::string_view level;
+    bool more = nextLevel(a_rest, level);
+    bool removed = false;
+    if (level == "+" || level == "#")
+    {
+        std::unique_ptr<Node> &child = (level == "+") ? a_node.singleLevel : a_node.multiLevel;
+        if (child && (removed = removeFrom(*child, a_rest, !more, a_subscriber)) && child->empty())
+        {
+            child.reset();
+        }
+        return removed;
+    }
+    auto entry = a_node.children.find(level);
+    if (entry != a_node.children.end() && (removed = removeFrom(*entry->second, a_rest, !more, a_subscriber)) && entry->second->empty())
+    {
+        a_node.children.erase(entry);
+    }
+    return removed;
+}
+
+bool TopicTrie::unsubscribe(std::string_view a_filter, int a_subscriber)
+{
+    if (!isValidFilter(a_filter) || !removeFrom(root, a_filter, false, a_subscriber))
+    {
+        return false;
+    }
+    subscriptionCount--;
+    return true;
+}
+
+void TopicTrie::collect(const Node &a_node, std::vector<int> &a_matches)
+{
+    a_matches.insert(a_matches.end(), a_node.subscribers.begin(), a_node.subscribers.end());
+}
+
+void TopicTrie::matchFrom(const Node &a_node, std::string_view a_rest, bool a_atEnd, std::vector<int> &a_matches) const
+{
+    /* "#" matches the parent level too ("a/#" gets "a"), and everything below*/
+    if (a_node.multiLevel)
+    {
+        collect(*a_node.multiLevel, a_matches);
+    }
+    if (a_atEnd)
+    {
+        collect(a_node, a_matches);
+        return;
+    }
+    std::string_view level;
+    bool more = nextLevel(a_rest, level);
+    auto entry = a_node.children.find(level);
+    if (entry != a_node.children.end())
+    {
+        matchFrom(*entry->second, a_rest, !more, a_matches);
+    }
+    if (a_node.singleLevel)
+    {
+        matchFrom(*a_node.singleLevel, a_rest, !more, a_matches);
+    }
+}
+
+void TopicTrie::match(std::string_view a_topic, std::vector<int> &a_matches) const
+{
+    a_matches.clear();
+    matchFrom(root, a_topic, false, a_matches);
+
+    /* A subscriber whose filters overlap ("a/+" and "a/#") gets the message once*/
+    std::sort(a_matches.begin(), a_matches.end());
+    a_matches.erase(std::unique(a_matches.begin(), a_matches.end()), a_matches.end());
+}
@@ -1,7 +1,18 @@
 #include "UDPSocket.hpp"
 
-UDPSocket::UDPSocket(CommunicationType a_CommunicationType, unsigned char a_ttl) : UDPSocketCommunicationType(a_CommunicationType), ttl(a_ttl)
+UDPSocket::UDPSocket(CommunicationType a_CommunicationType, unsigned char a_ttl, IOBackendType a_backend) : UDPSocketCommunicationType(a_CommunicationType), ttl(a_ttl), backend(a_backend)
 {
+    /* Falls back to blocking calls when io_uring isn't available (see TCPSocket::initBackend)*/
+    if (backend == IOBackendType::IO_URING)
+    {
+        ring = &IOUring::threadRing();
+        if (!ring->isReady())
+        {
+            ring = nullptr;
+            backend = IOBackendType::BLOCKING;
+        }
+    }
+
     /*
     ! 1 - Creating the Socket
     * AF_INET: IPv4 addressing.
@@ -9,27 +20,17 @@ UDPSocket::UDPSocket(CommunicationType a_CommunicationType, unsigned char a_ttl)
     * 0: Uses the default protocol for UDP.
     *
     * * If socket returns a negative value, it means the socket creation failed.
-    * In that case, an error message is printed, and the program exits.
+    * In that case every later operation returns an EBADF result.
     */
     sock = socket(AF_INET, SOCK_DGRAM, 0);
-    if (sock < 0)
-    {
-        /**
-         *! THROW
-         */
-        std::cerr << "Socket creation failed!" << std::endl;
-    }
-    if (UDPSocketCommunicationType == CommunicationType::MULTICAST)
+    memset(&address, 0, sizeof(address));
+    memset(&client_address, 0, sizeof(client_address));
+    memset(&mreq, 0, sizeof(mreq)); /* shutdown() relies on imr_multiaddr staying 0 until a group is joined*/
+    if (sock >= 0 && UDPSocketCommunicationType == CommunicationType::MULTICAST)
     {
+        /* Without SO_REUSEADDR only one receiver per host could join the group, the later bind then fails*/
         int reuse = 1;
-        if (setsockopt(sock, SOL_SOCKET, SO_REUSEADDR, (char *)&reuse, sizeof(reuse)) < 0)
-        {
-            /**
-             *! THROW
-             */
-            std::cerr << "Setting SO_REUSEADDR failed" << std::endl;
-            close(sock);
-        }
+        setsockopt(sock, SOL_SOCKET, SO_REUSEADDR, (char *)&reuse, sizeof(reuse));
     }
 }
 
@@ -38,38 +39,94 @@ const struct sockaddr_in *UDPSocket::getAddress() const
     return &address;
 }
 
-void UDPSocket::SetTTL(unsigned char a_ttl)
+int UDPSocket::getFD() const
 {
-    if (UDPSocketCommunicationType == CommunicationType::MULTICAST)
+    return sock;
+}
+
+SocketResult UDPSocket::setNonBlocking(bool a_nonBlocking)
+{
+    /* Same as TCPSocket::setNonBlocking: recvfrom/sendto return EAGAIN instead of blocking*/
+    int flags = fcntl(sock, F_GETFL, 0);
+    if (flags < 0)
     {
-        ttl = a_ttl;
-        if (setsockopt(sock, IPPROTO_IP, IP_MULTICAST_TTL, &ttl, sizeof(ttl)) < 0)
-        {
-            /**
-             *! THROW
-             */
-            std::cerr << "Failed to set TTL" << std::endl;
-            close(sock);
-        }
+        return SocketResult::fromErrno(errno);
     }
-    else
+    flags = a_nonBlocking ? (flags | O_NONBLOCK) : (flags & ~O_NONBLOCK);
+    if (fcntl(sock, F_SETFL, flags) < 0)
+    {
+        return SocketResult::fromErrno(errno);
+    }
+    nonBlocking = a_nonBlocking;
+    return SocketResult::success();
+}
+
+void UDPSocket::setTimeouts(const SocketTimeouts &a_timeouts)
+{
+    /* connectMs is unused: a UDP connect() only records the destination*/
+    timeouts = a_timeouts;
+}
+
+SocketTimeouts UDPSocket::getTimeouts() const
+{
+    return timeouts;
+}
+
+SocketResult UDPSocket::setTuning(const SocketTuning &a_tuning)
+{
+    /* TCP_NODELAY/TCP_CORK don't apply, a larger SO_RCVBUF absorbs bursts that would otherwise be dropped*/
+    SocketTuning previous = tuning;
+    tuning = a_tuning;
+    if (sock < 0)
+    {
+        return SocketResult::fromErrno(EBADF);
+    }
+    return tuning.apply(sock, false, previous);
+}
+
+SocketTuning UDPSocket::getTuning() const
+{
+    return tuning;
+}
+
+SocketResult UDPSocket::setBusyPoll(int a_spinBudgetUs)
+{
+    /* Same mode as TCPSocket::setBusyPoll, for receive()/receiveView() (receiveBatch doesn't spin)*/
+    if (sock < 0)
+    {
+        return SocketResult::fromErrno(EBADF);
+    }
+    busyPollBudgetUs = std::max(a_spinBudgetUs, 0);
+    int kernelBudget = (busyPollBudgetUs > 0) ? busyPollBudgetUs : std::max(tuning.busyPollUs, 0);
+    if (setsockopt(sock, SOL_SOCKET, SO_BUSY_POLL, &kernelBudget, sizeof(kernelBudget)) < 0 && errno != EPERM)
+    {
+        return SocketResult::fromErrno(errno);
+    }
+    return SocketResult::success();
+}
+
+SocketResult UDPSocket::SetTTL(unsigned char a_ttl)
+{
+    if (UDPSocketCommunicationType != CommunicationType::MULTICAST)
     {
-        std::cerr << "SetTTL was called for a unicast soccket!" << std::endl;
+        /* The TTL only applies to multicast packets*/
+        return SocketResult(SocketStatus::ERROR, 0, EINVAL);
     }
+    ttl = a_ttl;
+    if (setsockopt(sock, IPPROTO_IP, IP_MULTICAST_TTL, &ttl, sizeof(ttl)) < 0)
+    {
+        return SocketResult::fromErrno(errno);
+    }
+    return SocketResult::success();
 }
 
-void UDPSocket::JoinMulticast(const std::string &multicast_ip, int multicast_port)
+SocketResult UDPSocket::JoinMulticast(const std::string &multicast_ip, int multicast_port)
 {
     // Convert the IP to network byte order and check if it's a valid multicast address
     in_addr_t multicast_addr = inet_addr(multicast_ip.c_str());
     if (!IN_MULTICAST(ntohl(multicast_addr)))
     {
-        /**
-         *! THROW
-         */
-        std::cerr << "Provided IP is not a valid multicast address!" << std::endl;
-        close(sock);
-        return;
+        return SocketResult(SocketStatus::ERROR, 0, EINVAL);
     }
 
     /*
@@ -85,12 +142,7 @@ void UDPSocket::JoinMulticast(const std::string &multicast_ip, int multicast_por
 
     if (::bind(sock, (struct sockaddr *)&address, sizeof(address)) < 0)
     {
-        /**
-         *! THROW
-         */
-        std::cerr << "Bind failed" << std::endl;
-        close(sock);
-        return;
+        return SocketResult::fromErrno(errno);
     }
 
     /*
@@ -104,21 +156,23 @@ void UDPSocket::JoinMulticast(const std::string &multicast_ip, int multicast_por
 
     if (setsockopt(sock, IPPROTO_IP, IP_ADD_MEMBERSHIP, &mreq, sizeof(mreq)) < 0)
     {
-        /**
-         *! THROW
-         */
-        std::cerr << "Failed to join multicast group" << std::endl;
-        close(sock);
+        int error = errno;
+        memset(&mreq, 0, sizeof(mreq)); /* Not a member, shutdown() must not try to leave*/
+        return SocketResult::fromErrno(error);
     }
+    return SocketResult::success();
 }
 
-void UDPSocket::connect(const std::string &a_ip, int a_port) 
+SocketResult UDPSocket::connect(const std::string &a_ip, int a_port) 
 {
+    if (sock < 0)
+    {
+        return SocketResult(SocketStatus::ERROR, 0, EBADF);
+    }
     /*If the socket communication type is multicast call JoinMulticast */
     if (UDPSocketCommunicationType == CommunicationType::MULTICAST)
     {
-        JoinMulticast(a_ip, a_port);
-        return;
+        return JoinMulticast(a_ip, a_port);
     }
     /*
      ! 1- Defining the Server Address:
@@ -148,10 +202,7 @@ void UDPSocket::connect(const std::string &a_ip, int a_port)
      */
     if (inet_pton(AF_INET, a_ip.c_str(), &address.sin_addr) <= 0)
     {
-        /**
-         *! THROW
-         */
-        std::cerr << "Invalid address!" << std::endl;
+        return SocketResult(SocketStatus::ERROR, 0, EINVAL);
     }
 
     /*
@@ -160,11 +211,20 @@ void UDPSocket::connect(const std::string &a_ip, int a_port)
      ~  UDP does not use connect. Each sendto sends a datagram to the specified server,
      ~     regardless of any prior communication. UDP is stateless and connectionless,
      ~     meaning each datagram is independent.
+     *
+     * send() always targets client_address (the last peer for a server), so the server
+     * address becomes the destination of the client's datagrams.
      */
+    client_address = address;
+    return SocketResult::success();
 }
 
-void UDPSocket::bind(const std::string &a_ip, int a_port) 
+SocketResult UDPSocket::bind(const std::string &a_ip, int a_port) 
 {
+    if (sock < 0)
+    {
+        return SocketResult(SocketStatus::ERROR, 0, EBADF);
+    }
 
     /*
      ! 1 - Binding the Socket to an IP Address and Port
@@ -175,7 +235,6 @@ void UDPSocket::bind(const std::string &a_ip, int a_port)
      *          (host to network short) to ensure compatibility between different systems.
      */
 
-    int addrlen = sizeof(address);
     address.sin_family = AF_INET;
     address.sin_port = htons(a_port);
 
@@ -200,14 +259,12 @@ void UDPSocket::bind(const std::string &a_ip, int a_port)
     {
         if (a_ip.empty())
         {
-            /**
-             *! THROW
-             */
-            std::cerr << "No Multicast IP was provided!" << std::endl;
+            /* No Multicast IP was provided*/
+            return SocketResult(SocketStatus::ERROR, 0, EDESTADDRREQ);
         }
         address.sin_addr.s_addr = inet_addr(a_ip.c_str());
-        SetTTL(ttl);
-        return;
+        client_address = address; /* The multicast group is the destination of every send()*/
+        return SetTTL(ttl);
     }
     else
     {
@@ -219,23 +276,22 @@ void UDPSocket::bind(const std::string &a_ip, int a_port)
      *
      *
      * If bind fails (returns -1), it indicates that the port may already be in use,
-     * or the server lacks necessary permissions. An error message is printed, and the program exits.
+     * or the server lacks necessary permissions (EADDRINUSE / EACCES in the result).
      */
 
     if (::bind(sock, (struct sockaddr *)&address, sizeof(address)) < 0)
     {
-        /**
-         *! THROW
-         */
-        std::cerr << "Bind failed!" << std::endl;
+        return SocketResult::fromErrno(errno);
     }
+    return SocketResult::success();
 }
 
-void UDPSocket::listen(int backlog ) 
+SocketResult UDPSocket::listen(int backlog ) 
 {
     /*
      ! No Listen For UDP
     */
+    return SocketResult::success();
 }
 
 Socket *UDPSocket::accept() 
@@ -247,7 +303,7 @@ Socket *UDPSocket::accept()
     return nullptr;
 }
 
-void UDPSocket::send(const std::string &message) 
+SocketResult UDPSocket::send(const std::string &message) 
 {
     /*
      * send(sock, message, strlen(message), 0) sends the message "Hello from client" to the server.
@@ -257,16 +313,287 @@ void UDPSocket::send(const std::string &message)
      * strlen(message): the length of the data.
      * 0: no special flags are used.
      * */
-    if (sock >= 0)
+    MessageSegment segment = {message.data(), message.size()}; /* size(), not strlen: binary payloads may contain NUL bytes*/
+    return send(&segment, 1);
+}
+
+SocketResult UDPSocket::send(const MessageSegment *a_segments, size_t a_count)
+{
+    if (sock < 0)
+    {
+        return SocketResult(SocketStatus::ERROR, 0, EBADF);
+    }
+
+    if (backend == IOBackendType::IO_URING)
+    {
+        /* One IORING_OP_SENDMSG per datagram, submitted with the next batch*/
+        size_t length = 0;
+        for (size_t i = 0; i < a_count; i++)
+        {
+            length += a_segments[i].length;
+        }
+        if (length > MAX_DATAGRAM_SIZE)
+        {
+            statistics.add(SocketStats::ERRORS);
+            return SocketResult::fromErrno(EMSGSIZE); /* The kernel would only report it in the completion*/
+        }
+        UringDatagramRequest *request = acquireSendSlot();
+        if (request->payload.capacity() < length)
+        {
+            request->payload.grow(length, 0);
+        }
+        char *cursor = request->payload.data();
+        for (size_t i = 0; i < a_count; i++)
+        {
+            memcpy(cursor, a_segments[i].data, a_segments[i].length);
+            cursor += a_segments[i].length;
+        }
+        request->destination = client_address;
+        request->segment.iov_base = request->payload.data();
+        request->segment.iov_len = length;
+        memset(&request->header, 0, sizeof(request->header));
+        request->header.msg_name = &request->destination;
+        request->header.msg_namelen = sizeof(request->destination);
+        request->header.msg_iov = &request->segment;
+        request->header.msg_iovlen = 1;
+        ring->prepareSendMsg(sock, &request->header, 0, request);
+        if (ring->pendingSubmissions() >= IOUring::SUBMIT_BATCH)
+        {
+            ring->submit();
+        }
+        statistics.add(SocketStats::MESSAGES_OUT);
+        statistics.add(SocketStats::BYTES_OUT, length);
+        return SocketResult::success(length);
+    }
+
+    /*
+     ! sendmsg with several iovecs:
+     * The segments are gathered into ONE datagram addressed to client_address
+     * (same destination as sendto), so the receiver gets header and payload together.
+     */
+    struct iovec localSegments[16];
+    std::vector<struct iovec> heapSegments;
+    struct iovec *segments = localSegments;
+    if (a_count > 16)
+    {
+        heapSegments.resize(a_count);
+        segments = heapSegments.data();
+    }
+    for (size_t i = 0; i < a_count; i++)
+    {
+        segments[i] = {(void *)a_segments[i].data, a_segments[i].length};
+    }
+
+    struct msghdr message;
+    memset(&message, 0, sizeof(message));
+    message.msg_name = &client_address;
+    message.msg_namelen = sizeof(client_address);
+    message.msg_iov = segments;
+    message.msg_iovlen = a_count;
+    return sendHeader(&message);
+}
+
+SocketResult UDPSocket::sendHeader(struct msghdr *a_message, size_t a_datagrams)
+{
+    /*
+     * A datagram is sent whole or not at all, so only a full send buffer (EAGAIN) is waited on,
+     * until the send deadline. Without one a non-blocking socket returns WOULD_BLOCK.
+     */
+    Deadline deadline(timeouts.sendMs);
+    int flags = deadline.isInfinite() ? 0 : MSG_DONTWAIT;
+    while (true)
+    {
+        ssize_t sent = ::sendmsg(sock, a_message, flags);
+        statistics.add(SocketStats::SYSCALLS);
+        if (sent >= 0)
+        {
+            statistics.add(SocketStats::MESSAGES_OUT, a_datagrams);
+            statistics.add(SocketStats::BYTES_OUT, (uint64_t)sent);
+            return SocketResult::success((size_t)sent);
+        }
+        int error = errno;
+        if (error == EINTR)
+        {
+            continue;
+        }
+        statistics.add((error == EAGAIN || error == EWOULDBLOCK) ? SocketStats::WOULD_BLOCKS : SocketStats::ERRORS);
+        if ((error == EAGAIN || error == EWOULDBLOCK) && !deadline.isInfinite())
+        {
+            SocketResult ready = deadline.waitUntilReady(sock, POLLOUT);
+            if (!ready.ok())
+            {
+                return ready;
+            }
+            continue;
+        }
+        return SocketResult::fromErrno(error);
+    }
+}
+
+void UDPSocket::UringDatagramRequest::complete(int a_result)
+{
+    /* A failed datagram is dropped like any lost UDP packet*/
+    result = a_result;
+    completed = true;
+    owner->freeSlots.push_back(this);
+}
+
+UDPSocket::UringDatagramRequest *UDPSocket::acquireSendSlot()
+{
+    if (!sendSlots)
     {
-        ::sendto(sock, message.c_str(), strlen(message.c_str()), 0, (const struct sockaddr *)&client_address, sizeof(client_address));
+        sendSlots.reset(new UringDatagramRequest[URING_SEND_SLOTS]);
+        freeSlots.reserve(URING_SEND_SLOTS);
+        for (size_t i = 0; i < URING_SEND_SLOTS; i++)
+        {
+            sendSlots[i].owner = this;
+            sendSlots[i].completed = true; /* Free slots count as completed, see drainSends()*/
+            freeSlots.push_back(&sendSlots[i]);
+        }
+    }
+    /* Every slot in flight: submit them and sleep until one of them completes*/
+    for (size_t i = 0; freeSlots.empty(); i = (i + 1) % URING_SEND_SLOTS)
+    {
+        if (!sendSlots[i].completed)
+        {
+            ring->waitFor(sendSlots[i]);
+        }
+    }
+    UringDatagramRequest *request = freeSlots.back();
+    freeSlots.pop_back();
+    request->completed = false;
+    return request;
+}
+
+void UDPSocket::drainSends()
+{
+    /* The slots live in this object, the kernel must be done with them before it goes away*/
+    for (size_t i = 0; sendSlots && i < URING_SEND_SLOTS; i++)
+    {
+        while (!sendSlots[i].completed)
+        {
+            ring->waitFor(sendSlots[i]);
+        }
+    }
+}
+
+SocketResult UDPSocket::recvFromBytes(char *a_buffer, size_t a_length, struct sockaddr_in *a_from, int a_flags)
+{
+    /* Same deadline and busy-poll handling as TCPSocket::recvBytes (poll for the time left, MSG_DONTWAIT never waits)*/
+    Deadline deadline((a_flags & MSG_DONTWAIT) ? -1 : timeouts.receiveMs);
+    bool mayWait = backend == IOBackendType::BLOCKING && !nonBlocking && !(a_flags & MSG_DONTWAIT);
+    SpinBudget spin(mayWait ? busyPollBudgetUs : 0);
+    while (true)
+    {
+        socklen_t addrlen = sizeof(*a_from);
+        ssize_t bytes;
+        if (backend == IOBackendType::IO_URING)
+        {
+            if (!deadline.isInfinite())
+            {
+                ring->submit();
+                SocketResult ready = deadline.waitUntilReady(sock, POLLIN);
+                if (!ready.ok())
+                {
+                    return ready;
+                }
+            }
+            /* IORING_OP_RECVMSG is used instead of IORING_OP_RECV to get the sender address*/
+            struct iovec segment = {a_buffer, a_length};
+            struct msghdr header;
+            memset(&header, 0, sizeof(header));
+            header.msg_name = a_from;
+            header.msg_namelen = addrlen;
+            header.msg_iov = &segment;
+            header.msg_iovlen = 1;
+
+            IOUring::Request request;
+            ring->prepareRecvMsg(sock, &header, a_flags, &request);
+            ring->waitFor(request);
+            bytes = request.result;
+            if (bytes < 0)
+            {
+                errno = -request.result;
+            }
+            else if (header.msg_flags & MSG_TRUNC)
+            {
+                statistics.add(SocketStats::TRUNCATED_DATAGRAMS);
+            }
+        }
+        else
+        {
+            /* MSG_TRUNC: the real datagram length is returned, so a truncated datagram is detected*/
+            bytes = ::recvfrom(sock, a_buffer, a_length, a_flags | MSG_TRUNC | ((deadline.isInfinite() && !spin.isSpinning()) ? 0 : MSG_DONTWAIT), (struct sockaddr *)a_from, &addrlen);
+            if (bytes > (ssize_t)a_length)
+            {
+                statistics.add(SocketStats::TRUNCATED_DATAGRAMS);
+                bytes = (ssize_t)a_length;
+            }
+        }
+        statistics.add(SocketStats::SYSCALLS);
+
+        /* A zero-length datagram is a valid message, there is no "peer closed" for UDP*/
+        if (bytes >= 0)
+        {
+            if (spin.isSpinning())
+            {
+                statistics.add(SocketStats::SPIN_RECEIVES);
+            }
+            statistics.add(SocketStats::BYTES_IN, (uint64_t)bytes);
+            statistics.add(SocketStats::MESSAGES_IN);
+            if ((size_t)bytes < a_length)
+            {
+                statistics.add(SocketStats::SHORT_READS);
+            }
+            return SocketResult::success((size_t)bytes);
+        }
+        int error = errno;
+        if (error == EINTR)
+        {
+            continue;
+        }
+        if ((error == EAGAIN || error == EWOULDBLOCK) && spin.isSpinning())
+        {
+            if (!spin.keepSpinning())
+            {
+                statistics.add(SocketStats::SPIN_FALLBACKS);
+            }
+            continue;
+        }
+        statistics.add((error == EAGAIN || error == EWOULDBLOCK) ? SocketStats::WOULD_BLOCKS : SocketStats::ERRORS);
+        if ((error == EAGAIN || error == EWOULDBLOCK) && !deadline.isInfinite())
+        {
+            SocketResult ready = deadline.waitUntilReady(sock, POLLIN);
+            if (!ready.ok())
+            {
+                return ready;
+            }
+            continue;
+        }
+        return SocketResult::fromErrno(error);
     }
 }
 
 std::string UDPSocket::receive() 
 {
-    /* Create a vector that will grow as needed*/
-    std::vector<char> buffer(1024); /* Initial size of 1024, but can grow as needed*/
+    std::string message;
+    receive(message);
+    return message;
+}
+
+SocketResult UDPSocket::receive(std::string &a_message) 
+{
+    a_message.clear();
+    if (sock < 0)
+    {
+        return SocketResult(SocketStatus::ERROR, 0, EBADF);
+    }
+
+    /*
+     * A datagram is read whole by ONE recvfrom (a second call would return the next datagram),
+     * so the pooled buffer is large enough for any UDP payload (see BufferPool).
+     */
+    BufferPool::Buffer buffer(MAX_DATAGRAM_SIZE);
     /**
      * ! recvfrom Function (for UDP)
      * * The recvfrom function is used for receiving data on a socket (UDP).
@@ -280,41 +607,366 @@ std::string UDPSocket::receive()
      * ~ addrlen: A pointer to the size of the address structure.
      *
      */
-    socklen_t addrlen = sizeof(client_address);
+    SocketResult result = recvFromBytes(buffer.data(), buffer.capacity(), &client_address);
 
-    int bytes = ::recvfrom(sock, buffer.data(), buffer.size(), 0, (struct sockaddr *)&client_address, &addrlen);
+    // Nothing received (WOULD_BLOCK only means a non-blocking socket has nothing queued)
+    if (!result.ok())
+    {
+        return result;
+    }
+    size_t bytes = result.bytes;
 
-    // Check if an error occurred
-    if (bytes < 0)
+    a_message.assign(buffer.data(), bytes); /* Construct a string from the received data*/
+    return SocketResult::success(bytes);
+}
+
+SocketResult UDPSocket::receive(char *a_buffer, size_t a_length)
+{
+    /*
+     * Allocation-free variant of receive(): one datagram straight into the caller's buffer,
+     * the sender becomes client_address. A datagram longer than a_length is truncated.
+     */
+    if (sock < 0)
     {
-        std::cerr << "Failed to receive data." << std::endl;
-        return "";
+        return SocketResult(SocketStatus::ERROR, 0, EBADF);
     }
+    return recvFromBytes(a_buffer, a_length, &client_address);
+}
 
-    /* If more data is received than the buffer can hold, resize the buffer*/
-    if (bytes == buffer.size())
+SocketResult UDPSocket::receiveView(const char *&a_data, size_t &a_length)
+{
+    /* One datagram into the socket's view buffer (sized for any UDP payload), the sender becomes client_address*/
+    if (sock < 0)
     {
-        buffer.resize(buffer.size() * 2); /* Double the buffer size for the next read*/
-        /*
-         ! recvfrom is called again to receive any remaining data.
-         * Parameters:
-         * buffer.data() + bytes is a pointer to the start of the newly added portion of the buffer.
-         * buffer.data() gives a pointer to the start of the buffer.
-         *   + bytes moves this pointer to the position where the initial recvfrom call left off, so new data will be added after the existing data.
-         *  buffer.size() - bytes is the remaining space in the buffer after the initial data, providing the maximum number of bytes recvfrom can read into the expanded buffer.
-         *
-         * additional_bytes stores the number of bytes received in this second call.
-         */
-        int additional_bytes = ::recvfrom(sock, buffer.data() + bytes, buffer.size() - bytes, 0, (struct sockaddr *)&address, &addrlen);
+        return SocketResult(SocketStatus::ERROR, 0, EBADF);
+    }
+    if (viewBuffer.data() == nullptr)
+    {
+        viewBuffer = BufferPool::Buffer(MAX_DATAGRAM_SIZE);
+    }
+    SocketResult result = recvFromBytes(viewBuffer.data(), viewBuffer.capacity(), &client_address);
+    if (result.ok())
+    {
+        a_data = viewBuffer.data();
+        a_length = result.bytes;
+    }
+    return result;
+}
+
+SocketResult UDPSocket::receiveBatch(DatagramBatch &a_batch, bool a_waitForFirst, size_t a_maxCount)
+{
+    /**
+     * ! recvmmsg Function
+     * * Receives up to vlen datagrams in one system call, each into its own mmsghdr
+     * * (payload iovec + sender address), and returns how many were received.
+     *
+     * ~ MSG_WAITFORONE: block until the first datagram arrives, then only take what is already queued.
+     * ~ MSG_DONTWAIT: never block, return 0 when nothing is queued.
+     *
+     * With a receive deadline the wait for the first datagram is a poll bounded by it.
+     * a_maxCount (0 = the batch capacity) limits how many datagrams are taken.
+     * result.bytes is the number of datagrams. The sender of the last datagram becomes
+     * client_address, like after receive(), so send() replies to it.
+     */
+    a_batch.prepare();
+    if (sock < 0)
+    {
+        return SocketResult(SocketStatus::ERROR, 0, EBADF);
+    }
+    Deadline deadline(a_waitForFirst ? timeouts.receiveMs : -1);
+    int flags = (a_waitForFirst && deadline.isInfinite()) ? MSG_WAITFORONE : MSG_DONTWAIT;
+    while (true)
+    {
+        size_t limit = (a_maxCount > 0 && a_maxCount < a_batch.capacity()) ? a_maxCount : a_batch.capacity();
+        int count = recvmmsg(sock, a_batch.headers.data(), (unsigned int)limit, flags, nullptr);
+        statistics.add(SocketStats::SYSCALLS);
+        if (count >= 0)
+        {
+            a_batch.received = (size_t)count;
+            a_batch.parseSegments((size_t)count);
+            uint64_t bytes = 0;
+            uint64_t datagrams = 0;
+            for (size_t i = 0; i < (size_t)count; i++)
+            {
+                bytes += a_batch.length(i);
+                datagrams += a_batch.segmentCount(i);
+                if (a_batch.truncated(i))
+                {
+                    statistics.add(SocketStats::TRUNCATED_DATAGRAMS);
+                }
+            }
+            statistics.add(SocketStats::MESSAGES_IN, datagrams);
+            statistics.add(SocketStats::BYTES_IN, bytes);
+            if (count > 0)
+            {
+                client_address = a_batch.senders[count - 1];
+            }
+            return SocketResult::success((size_t)count);
+        }
+        int error = errno;
+        if (error == EINTR)
+        {
+            continue;
+        }
+        statistics.add((error == EAGAIN || error == EWOULDBLOCK) ? SocketStats::WOULD_BLOCKS : SocketStats::ERRORS);
+        if ((error == EAGAIN || error == EWOULDBLOCK) && !deadline.isInfinite())
+        {
+            SocketResult ready = deadline.waitUntilReady(sock, POLLIN);
+            if (!ready.ok())
+            {
+                return ready;
+            }
+            continue;
+        }
+        if ((error == EAGAIN || error == EWOULDBLOCK) && !a_waitForFirst)
+        {
+            return SocketResult::success(0);
+        }
+        return SocketResult::fromErrno(error);
+    }
+}
+
+SocketResult UDPSocket::enableGRO(bool a_enable)
+{
+    /*
+     ! UDP_GRO:
+     * The kernel may deliver consecutive datagrams of one sender as a single coalesced buffer
+     * (one wakeup and one copy for up to 64 datagrams). receiveBatch() reports where the
+     * datagrams are (DatagramBatch::segment); receive() would return them concatenated.
+     */
+    int value = a_enable ? 1 : 0;
+    if (setsockopt(sock, SOL_UDP, UDP_GRO, &value, sizeof(value)) < 0)
+    {
+        return SocketResult::fromErrno(errno);
+    }
+    return SocketResult::success();
+}
+
+SocketResult UDPSocket::sendSegmented(const void *a_data, size_t a_length, size_t a_segmentSize)
+{
+    /*
+     ! UDP_SEGMENT (GSO):
+     * One sendmsg hands the kernel a buffer of up to 64 datagrams, tagged with the segment size
+     * in a control message; it is split into datagrams of a_segmentSize bytes (the last may be
+     * shorter) as late as possible, by the NIC when it supports UDP segmentation offload.
+     * The route and the headers are worked out once per buffer instead of once per datagram.
+     *
+     * Larger buffers are sent in chunks of 64 segments (at most one IP packet, 65507 bytes).
+     * The same datagrams go through sendmmsg when the kernel has no UDP GSO (before 4.18, found
+     * by probing the option once), when the device can't checksum them (EIO), or when the
+     * segment size is above the path MTU (EINVAL, EMSGSIZE on some kernels: GSO never fragments,
+     * sendmmsg lets IP do it).
+     * result.bytes is the number of payload bytes sent.
+     */
+    if (sock < 0)
+    {
+        return SocketResult(SocketStatus::ERROR, 0, EBADF);
+    }
+    if (a_segmentSize == 0 || a_segmentSize > MAX_DATAGRAM_SIZE)
+    {
+        return SocketResult(SocketStatus::ERROR, 0, EINVAL);
+    }
+    const char *data = (const char *)a_data;
+    size_t chunkSize = std::min(MAX_GSO_SEGMENTS, MAX_DATAGRAM_SIZE / a_segmentSize) * a_segmentSize;
+    bool segmenting = probeGso() && (gsoRejectedSize == 0 || a_segmentSize < gsoRejectedSize);
+    size_t sent = 0;
+    while (sent < a_length)
+    {
+        size_t length = std::min(chunkSize, a_length - sent);
+        SocketResult result = segmenting ? sendChunk(data + sent, length, a_segmentSize)
+                                         : sendChunkFallback(data + sent, length, a_segmentSize);
+        if (!result.ok() && segmenting && (result.errorNumber == EIO || result.errorNumber == ENOPROTOOPT))
+        {
+            gsoState = GsoState::UNSUPPORTED;
+            segmenting = false;
+            continue;
+        }
+        if (!result.ok() && segmenting && (result.errorNumber == EINVAL || result.errorNumber == EMSGSIZE) && length > a_segmentSize)
+        {
+            /* Only this size and larger ones: a smaller segment may still fit the MTU*/
+            gsoRejectedSize = (gsoRejectedSize == 0) ? a_segmentSize : std::min(gsoRejectedSize, a_segmentSize);
+            segmenting = false;
+            continue;
+        }
+        if (!result.ok())
+        {
+            result.bytes = sent;
+            return result;
+        }
+        sent += length;
+    }
+    return SocketResult::success(sent);
+}
+
+bool UDPSocket::probeGso()
+{
+    /* The kernel knows the option when it can read it back (0: no default segment size)*/
+    if (gsoState == GsoState::UNKNOWN)
+    {
+        int value = 0;
+        socklen_t length = sizeof(value);
+        if (getsockopt(sock, SOL_UDP, UDP_SEGMENT, &value, &length) == 0)
+        {
+            gsoState = GsoState::SUPPORTED;
+        }
+        else if (errno == ENOPROTOOPT || errno == EOPNOTSUPP)
+        {
+            gsoState = GsoState::UNSUPPORTED;
+        }
+        /* Any other error leaves it unknown, the next call probes again*/
+    }
+    return gsoState != GsoState::UNSUPPORTED;
+}
+
+SocketResult UDPSocket::sendChunk(const char *a_data, size_t a_length, size_t a_segmentSize)
+{
+    struct iovec segment = {(void *)a_data, a_length};
+    struct msghdr message;
+    memset(&message, 0, sizeof(message));
+    message.msg_name = &client_address;
+    message.msg_namelen = sizeof(client_address);
+    message.msg_iov = &segment;
+    message.msg_iovlen = 1;
+
+    /* A single datagram needs no segmentation (the control message is only added for two or more)*/
+    char control[CMSG_SPACE(sizeof(uint16_t))] = {};
+    if (a_length > a_segmentSize)
+    {
+        message.msg_control = control;
+        message.msg_controllen = sizeof(control);
+        struct cmsghdr *header = CMSG_FIRSTHDR(&message);
+        header->cmsg_level = SOL_UDP;
+        header->cmsg_type = UDP_SEGMENT;
+        header->cmsg_len = CMSG_LEN(sizeof(uint16_t));
+        uint16_t size = (uint16_t)a_segmentSize;
+        memcpy(CMSG_DATA(header), &size, sizeof(size));
+    }
+    return sendHeader(&message, (a_length + a_segmentSize - 1) / a_segmentSize);
+}
+
+SocketResult UDPSocket::sendChunkFallback(const char *a_data, size_t a_length, size_t a_segmentSize)
+{
+    /* Same datagrams without GSO: one mmsghdr per segment, still one system call*/
+    struct iovec segments[MAX_GSO_SEGMENTS];
+    struct mmsghdr headers[MAX_GSO_SEGMENTS];
+    size_t count = 0;
+    for (size_t offset = 0; offset < a_length; offset += a_segmentSize)
+    {
+        segments[count] = {(void *)(a_data + offset), std::min(a_segmentSize, a_length - offset)};
+        memset(&headers[count], 0, sizeof(headers[count]));
+        headers[count].msg_hdr.msg_name = &client_address;
+        headers[count].msg_hdr.msg_namelen = sizeof(client_address);
+        headers[count].msg_hdr.msg_iov = &segments[count];
+        headers[count].msg_hdr.msg_iovlen = 1;
+        count++;
+    }
+    return sendBatch(headers, count);
+}
+
+SocketResult UDPSocket::publish(MulticastGroups &a_groups, const std::string &message)
+{
+    MessageSegment segment = {message.data(), message.size()};
+    return publish(a_groups, &segment, 1);
+}
+
+SocketResult UDPSocket::publish(MulticastGroups &a_groups, const MessageSegment *a_segments, size_t a_count)
+{
+    /* Every header gathers the same iovecs: the payload is sent to each group without being copied*/
+    struct iovec localSegments[16];
+    std::vector<struct iovec> heapSegments;
+    struct iovec *segments = localSegments;
+    if (a_count > 16)
+    {
+        heapSegments.resize(a_count);
+        segments = heapSegments.data();
+    }
+    for (size_t i = 0; i < a_count; i++)
+    {
+        segments[i] = {(void *)a_segments[i].data, a_segments[i].length};
+    }
+    for (size_t i = 0; i < a_groups.size(); i++)
+    {
+        a_groups.headers[i].msg_hdr.msg_iov = segments;
+        a_groups.headers[i].msg_hdr.msg_iovlen = a_count;
+    }
+    return sendBatch(a_groups.headers.data(), a_groups.size());
+}
 
-        /*This is a safeguard to handle cases where the second recvfrom may not receive any additional data.*/
-        if (additional_bytes > 0)
+SocketResult UDPSocket::publishEach(MulticastGroups &a_groups, const MessageSegment *a_payloads)
+{
+    for (size_t i = 0; i < a_groups.size(); i++)
+    {
+        a_groups.segments[i] = {(void *)a_payloads[i].data, a_payloads[i].length};
+        a_groups.headers[i].msg_hdr.msg_iov = &a_groups.segments[i];
+        a_groups.headers[i].msg_hdr.msg_iovlen = 1;
+    }
+    return sendBatch(a_groups.headers.data(), a_groups.size());
+}
+
+SocketResult UDPSocket::sendBatch(struct mmsghdr *a_headers, size_t a_count)
+{
+    /**
+     * ! sendmmsg Function
+     * * Sends every mmsghdr (destination + payload iovecs) as its own datagram in one system call
+     * * and returns how many were sent, so publishing to dozens of groups per tick costs one
+     * * system call instead of one sendto per group.
+     *
+     * The kernel may stop early (full send buffer, or more than UIO_MAXIOV messages): the rest is
+     * sent by the next call, waiting for POLLOUT until the send deadline like send().
+     * result.bytes is the number of datagrams sent. The io_uring backend uses the same call
+     * (there is no batched sendmsg operation to queue).
+     */
+    if (sock < 0)
+    {
+        return SocketResult(SocketStatus::ERROR, 0, EBADF);
+    }
+    Deadline deadline(timeouts.sendMs);
+    int flags = deadline.isInfinite() ? 0 : MSG_DONTWAIT;
+    size_t sent = 0;
+    while (sent < a_count)
+    {
+        int count = sendmmsg(sock, a_headers + sent, (unsigned int)(a_count - sent), flags);
+        statistics.add(SocketStats::SYSCALLS);
+        if (count > 0)
+        {
+            /* msg_len is filled in by the kernel for every datagram it took*/
+            uint64_t bytes = 0;
+            for (int i = 0; i < count; i++)
+            {
+                bytes += a_headers[sent + i].msg_len;
+            }
+            statistics.add(SocketStats::MESSAGES_OUT, (uint64_t)count);
+            statistics.add(SocketStats::BYTES_OUT, bytes);
+            sent += (size_t)count;
+            continue;
+        }
+        int error = (count < 0) ? errno : EAGAIN;
+        if (error == EINTR)
+        {
+            continue;
+        }
+        statistics.add((error == EAGAIN || error == EWOULDBLOCK) ? SocketStats::WOULD_BLOCKS : SocketStats::ERRORS);
+        if ((error == EAGAIN || error == EWOULDBLOCK) && !deadline.isInfinite())
         {
-            bytes += additional_bytes;
+            SocketResult ready = deadline.waitUntilReady(sock, POLLOUT);
+            if (!ready.ok())
+            {
+                ready.bytes = sent;
+                return ready;
+            }
+            continue;
         }
+        return SocketResult::fromErrno(error, sent);
     }
+    return SocketResult::success(sent);
+}
 
-    return std::string(buffer.data(), bytes); /* Construct a string from the received data*/
+void UDPSocket::flush()
+{
+    if (backend == IOBackendType::IO_URING)
+    {
+        ring->submit();
+    }
 }
 
 void UDPSocket::LeaveMulticast(void)
@@ -328,6 +980,10 @@ void UDPSocket::shutdown()
     */
     if (sock >= 0)
     {
+        /* Queued io_uring datagrams must reach the kernel before the descriptor number is released*/
+        flush();
+        drainSends();
+
         /*
          ! Leave Multicast should only be exceuted for a UDP Socket client in Multicast
          ~ 1st condition : Checks if the socket is used in multicast
@@ -358,3 +1014,8 @@ void UDPSocket::shutdown()
         sock = -1;
     }
 }
+
+UDPSocket::~UDPSocket()
+{
+    drainSends();
+}
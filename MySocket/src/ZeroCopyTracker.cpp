@@ -0,0 +1,185 @@
+#include "ZeroCopyTracker.hpp"
+#include <linux/errqueue.h> // For sock_extended_err and SO_EE_ORIGIN_ZEROCOPY
+#include <netinet/in.h>     // For IPPROTO_IP / IP_RECVERR
+#include <sys/socket.h>
+#include <cerrno>
+#include <cstring>
+
+ZeroCopyTracker::ZeroCopyTracker() : nextId(0), copiedCompletions(0) {}
+
+char *ZeroCopyTracker::open(ReleaseCallback a_release)
+{
+    /* Starts the entry of the next buffer (an unfinished one is closed), returns its prefix storage*/
+    close();
+    pending.push_back({0, 0, 0, 0, true, std::move(a_release), {}});
+    return pending.back().prefix;
+}
+
+char *ZeroCopyTracker::openPrefix()
+{
+    /* The entry of a buffer whose send was interrupted, nullptr when there is none*/
+    return (!pending.empty() && pending.back().open) ? pending.back().prefix : nullptr;
+}
+
+uint32_t ZeroCopyTracker::sendCompleted()
+{
+    /* Called after every successful sendmsg(MSG_ZEROCOPY): returns the id the kernel used for it*/
+    uint32_t id = nextId++;
+    if (!pending.empty() && pending.back().open)
+    {
+        PendingBuffer &buffer = pending.back();
+        if (buffer.sentCalls == 0)
+        {
+            buffer.firstId = id;
+        }
+        buffer.lastId = id;
+        buffer.sentCalls++;
+        buffer.outstandingCalls++;
+    }
+    return id;
+}
+
+void ZeroCopyTracker::close()
+{
+    /* The buffer is fully sent (or failed): released now if the kernel already completed every call*/
+    if (pending.empty() || !pending.back().open)
+    {
+        return;
+    }
+    pending.back().open = false;
+    if (pending.back().outstandingCalls == 0)
+    {
+        ReleaseCallback release = std::move(pending.back().release);
+        pending.pop_back();
+        if (release)
+        {
+            release();
+        }
+    }
+}
+
+void ZeroCopyTracker::complete(uint32_t a_firstId, uint32_t a_lastId)
+{
+    /*
+     * Ids are compared as distances from a_firstId so the ranges stay correct when
+     * the 32-bit counter wraps around.
+     */
+    uint32_t span = a_lastId - a_firstId;
+    for (auto buffer = pending.begin(); buffer != pending.end();)
+    {
+        if (buffer->sentCalls == 0)
+        {
+            ++buffer;
+            continue;
+        }
+        uint32_t covered = 0;
+        for (uint32_t id = buffer->firstId;; id++)
+        {
+            if (id - a_firstId <= span)
+            {
+                covered++;
+            }
+            if (id == buffer->lastId)
+            {
+                break;
+            }
+        }
+        buffer->outstandingCalls -= (covered < buffer->outstandingCalls) ? covered : buffer->outstandingCalls;
+        if (buffer->outstandingCalls == 0 && !buffer->open)
+        {
+            ReleaseCallback release = std::move(buffer->release);
+            buffer = pending.erase(buffer);
+            if (release)
+            {
+                release();
+            }
+        }
+        else
+        {
+            ++buffer;
+        }
+    }
+}
+
+size_t ZeroCopyTracker::readCompletions(int a_fd)
+{
+    /*
+     ! recvmsg(MSG_ERRQUEUE):
+     * Zero-copy completions are queued on the socket error queue as an IP_RECVERR control message
+     * holding a sock_extended_err with ee_origin == SO_EE_ORIGIN_ZEROCOPY and the completed id
+     * range in [ee_info, ee_data]. The queue is read without blocking until it is empty.
+     * SO_EE_CODE_ZEROCOPY_COPIED means the kernel copied after all (no pages were pinned).
+     */
+    size_t notifications = 0;
+    while (!pending.empty())
+    {
+        char control[128];
+        struct msghdr message;
+        memset(&message, 0, sizeof(message));
+        message.msg_control = control;
+        message.msg_controllen = sizeof(control);
+
+        if (::recvmsg(a_fd, &message, MSG_ERRQUEUE | MSG_DONTWAIT) < 0)
+        {
+            break; /* EAGAIN: no more notifications for now*/
+        }
+
+        for (struct cmsghdr *cmsg = CMSG_FIRSTHDR(&message); cmsg != nullptr; cmsg = CMSG_NXTHDR(&message, cmsg))
+        {
+            if (!((cmsg->cmsg_level == SOL_IP && cmsg->cmsg_type == IP_RECVERR) ||
+                  (cmsg->cmsg_level == SOL_IPV6 && cmsg->cmsg_type == IPV6_RECVERR)))
+            {
+                continue;
+            }
+            struct sock_extended_err error;
+            memcpy(&error, CMSG_DATA(cmsg), sizeof(error));
+            if (error.ee_errno != 0 || error.ee_origin != SO_EE_ORIGIN_ZEROCOPY)
+            {
+                continue;
+            }
+            if (error.ee_code & SO_EE_CODE_ZEROCOPY_COPIED)
+            {
+                copiedCompletions++;
+            }
+            complete(error.ee_info, error.ee_data);
+            notifications++;
+        }
+    }
+    return notifications;
+}
+
+void ZeroCopyTracker::releaseAll()
+{
+    /* Used once the socket is closed: no further notification can arrive*/
+    while (!pending.empty())
+    {
+        ReleaseCallback release = std::move(pending.front().release);
+        pending.pop_front();
+        if (release)
+        {
+            release();
+        }
+    }
+}
+
+size_t ZeroCopyTracker::pendingBuffers() const
+{
+    return pending.size();
+}
+
+bool ZeroCopyTracker::hasOutstandingCalls() const
+{
+    for (const PendingBuffer &buffer : pending)
+    {
+        if (buffer.outstandingCalls > 0)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+size_t ZeroCopyTracker::copiedCount() const
+{
+    return copiedCompletions;
+}